@@ -0,0 +1,175 @@
+/**
+ * @file approximate_hull.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief An approximate convex hull within a known distance of the exact one, found in two streaming passes
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <vector>
+#include "convex_hull.hpp"
+#include "point_buffer.hpp"
+#include "thread_pool.hpp"
+
+#define APPROXIMATE_STRIP_COUNT 256
+#define APPROXIMATE_GRAIN_SIZE 65536
+
+/**
+ * @brief An approximate hull and how far it can be from the exact one
+ */
+struct ApproximateHull
+{
+    /**
+     * @brief The hull, a convex polygon of input points in counter-clockwise order starting from the lowest leftmost point;
+     * it is inside the exact hull
+     */
+    std::vector<Point> hull;
+
+    /**
+     * @brief Every input point is within this distance of the hull
+     */
+    double error_bound = 0;
+};
+
+/**
+ * @brief Get the distance within which every point is of the hull approximate_hull finds
+ *
+ * @param strip_count the number of vertical strips
+ * @param min_x the smallest x coordinate of the points
+ * @param max_x the largest x coordinate of the points
+ * @return double the width of a strip, (max_x - min_x) / strip_count
+ */
+double approximate_hull_error(size_t strip_count, double min_x, double max_x)
+{
+    return (max_x - min_x) / (double)std::max(strip_count, (size_t)1);
+}
+
+/**
+ * @brief Find an approximate hull of a set of points, after Bentley, Faust and Preparata
+ * the x range of the points is cut into vertical strips of equal width; the lowest and the highest point of every strip,
+ * along with the lexicographically smallest and largest points, are the only candidates given to the monotone chain. A
+ * point lies between the lowest and the highest point of its strip, so it is at most a strip width from the segment
+ * between them. Both passes are parallel and do a constant amount of work per point
+ *
+ * @tparam PointAt a function from an index to the Point at that index
+ * @param count the number of points
+ * @param point_at the accessor
+ * @param strip_count the number of strips, the hull has at most 2 * strip_count + 2 vertices
+ * @param pool the pool running the passes
+ * @param grain_size the minimum number of points in a chunk
+ * @return ApproximateHull
+ */
+template <typename PointAt>
+ApproximateHull approximate_hull_of(size_t count, PointAt point_at, size_t strip_count, ThreadPool &pool, size_t grain_size)
+{
+    ApproximateHull result;
+    if (count == 0)
+    {
+        return result;
+    }
+    strip_count = std::max(strip_count, (size_t)1);
+    size_t chunk_count = parallel_chunk_count(pool, count, grain_size);
+
+    // the lexicographic extremes, which give the x range
+    std::vector<Point> chunk_lowest(chunk_count), chunk_highest(chunk_count);
+    parallel_chunks(pool, 0, count, chunk_count, [&](size_t chunk, size_t chunk_begin, size_t chunk_end)
+                    {
+        Point lowest = point_at(chunk_begin), highest = lowest;
+        for (size_t i = chunk_begin + 1; i < chunk_end; i++)
+        {
+            Point p = point_at(i);
+            lowest = p < lowest ? p : lowest;
+            highest = highest < p ? p : highest;
+        }
+        chunk_lowest[chunk] = lowest;
+        chunk_highest[chunk] = highest; });
+    Point lowest = *min_element(chunk_lowest.begin(), chunk_lowest.end());
+    Point highest = *max_element(chunk_highest.begin(), chunk_highest.end());
+
+    double min_x = lowest.get_x(), extent = highest.get_x() - min_x;
+    double scale = extent > 0 ? (double)strip_count / extent : 0;
+    result.error_bound = approximate_hull_error(strip_count, min_x, highest.get_x());
+
+    // the lowest and highest point of every strip, per chunk
+    std::vector<Point> strip_bottoms(chunk_count * strip_count, Point(0, INF_DOUBLE));
+    std::vector<Point> strip_tops(chunk_count * strip_count, Point(0, -INF_DOUBLE));
+    parallel_chunks(pool, 0, count, chunk_count, [&](size_t chunk, size_t chunk_begin, size_t chunk_end)
+                    {
+        Point *bottoms = strip_bottoms.data() + chunk * strip_count, *tops = strip_tops.data() + chunk * strip_count;
+        for (size_t i = chunk_begin; i < chunk_end; i++)
+        {
+            Point p = point_at(i);
+            size_t strip = std::min((size_t)((p.get_x() - min_x) * scale), strip_count - 1);
+            if (p.get_y() < bottoms[strip].get_y())
+            {
+                bottoms[strip] = p;
+            }
+            if (p.get_y() > tops[strip].get_y())
+            {
+                tops[strip] = p;
+            }
+        } });
+
+    std::vector<Point> candidates = {lowest, highest};
+    for (size_t strip = 0; strip < strip_count; strip++)
+    {
+        Point bottom = strip_bottoms[strip], top = strip_tops[strip];
+        for (size_t chunk = 1; chunk < chunk_count; chunk++)
+        {
+            Point chunk_bottom = strip_bottoms[chunk * strip_count + strip], chunk_top = strip_tops[chunk * strip_count + strip];
+            bottom = chunk_bottom.get_y() < bottom.get_y() ? chunk_bottom : bottom;
+            top = chunk_top.get_y() > top.get_y() ? chunk_top : top;
+        }
+        // an empty strip keeps the infinite sentinels
+        if (bottom.get_y() <= top.get_y())
+        {
+            candidates.push_back(bottom);
+            candidates.push_back(top);
+        }
+    }
+    result.hull = monotone_chain(candidates);
+    return result;
+}
+
+/**
+ * @brief Find an approximate hull of a set of points, with every point within a strip width of it
+ *
+ * @param points given set of points
+ * @param strip_count the number of strips, the error bound is the x extent of the points divided by it
+ * @param pool the pool running the passes
+ * @param grain_size the minimum number of points in a chunk
+ * @return ApproximateHull
+ */
+ApproximateHull approximate_hull(std::span<const Point> points, size_t strip_count = APPROXIMATE_STRIP_COUNT, ThreadPool &pool = default_thread_pool(), size_t grain_size = APPROXIMATE_GRAIN_SIZE)
+{
+    return approximate_hull_of(
+        points.size(), [points](size_t i)
+        { return points[i]; },
+        strip_count, pool, grain_size);
+}
+
+/**
+ * @brief Find an approximate hull of a structure-of-arrays buffer, with every point within a strip width of it
+ *
+ * @param points given set of points
+ * @param strip_count the number of strips, the error bound is the x extent of the points divided by it
+ * @param pool the pool running the passes
+ * @param grain_size the minimum number of points in a chunk
+ * @return ApproximateHull
+ */
+ApproximateHull approximate_hull(const PointBuffer &points, size_t strip_count = APPROXIMATE_STRIP_COUNT, ThreadPool &pool = default_thread_pool(), size_t grain_size = APPROXIMATE_GRAIN_SIZE)
+{
+    const double *xs = points.x(), *ys = points.y();
+    return approximate_hull_of(
+        points.size(), [xs, ys](size_t i)
+        { return Point(xs[i], ys[i]); },
+        strip_count, pool, grain_size);
+}
@@ -0,0 +1,212 @@
+/**
+ * @file arena.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief Memory resources for the hull engines: a reusable scratch arena and a resource counting the allocations
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#define ARENA_INITIAL_SIZE (64 * 1024)
+
+/**
+ * @brief A memory resource passing every request to another one and counting them
+ * wrapped around the upstream of an arena, it proves that repeated hulls stop reaching the heap
+ */
+class CountingResource : public std::pmr::memory_resource
+{
+private:
+    std::pmr::memory_resource *upstream;
+    std::atomic<size_t> allocation_count, deallocation_count, allocated_bytes;
+
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        return upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *pointer, size_t bytes, size_t alignment) override
+    {
+        deallocation_count.fetch_add(1, std::memory_order_relaxed);
+        upstream->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+public:
+    /**
+     * @brief Construct a new Counting Resource object
+     *
+     * @param upstream_to_set the resource the requests are passed to, the heap by default
+     */
+    explicit CountingResource(std::pmr::memory_resource *upstream_to_set = std::pmr::new_delete_resource())
+        : upstream(upstream_to_set), allocation_count(0), deallocation_count(0), allocated_bytes(0)
+    {
+    }
+
+    /**
+     * @brief Get the number of allocations so far
+     *
+     * @return size_t
+     */
+    size_t allocations() const
+    {
+        return allocation_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of deallocations so far
+     *
+     * @return size_t
+     */
+    size_t deallocations() const
+    {
+        return deallocation_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of bytes allocated so far, deallocations are not subtracted
+     *
+     * @return size_t
+     */
+    size_t bytes() const
+    {
+        return allocated_bytes.load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief A reusable scratch arena for the hull engines
+ * allocating bumps a pointer and deallocating does nothing, so the engines never contend on the heap; reset() makes all
+ * the memory available again, and merges the blocks one hull needed into a single block, so once a hull of the same size
+ * has run, repeating it allocates nothing from the upstream resource. The arena is not thread-safe: every worker thread
+ * owns its own
+ */
+class HullArena : public std::pmr::memory_resource
+{
+private:
+    /**
+     * @brief The header at the start of every block, the blocks form a list from the newest one
+     */
+    struct Block
+    {
+        Block *previous;
+        size_t size;
+    };
+
+    std::pmr::memory_resource *upstream;
+    Block *blocks;
+
+    /**
+     * @brief The free part of the newest block
+     */
+    std::byte *cursor, *limit;
+
+    /**
+     * @brief The total size of the blocks, and the size reset() merges them into
+     */
+    size_t capacity, merged_size;
+
+    void add_block(size_t size)
+    {
+        Block *block = static_cast<Block *>(upstream->allocate(size, alignof(std::max_align_t)));
+        block->previous = blocks;
+        block->size = size;
+        blocks = block;
+        cursor = reinterpret_cast<std::byte *>(block) + sizeof(Block);
+        limit = reinterpret_cast<std::byte *>(block) + size;
+        capacity += size;
+    }
+
+    void release_blocks()
+    {
+        while (blocks != nullptr)
+        {
+            Block *previous = blocks->previous;
+            upstream->deallocate(blocks, blocks->size, alignof(std::max_align_t));
+            blocks = previous;
+        }
+        cursor = limit = nullptr;
+        capacity = 0;
+    }
+
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        uintptr_t aligned = ((uintptr_t)cursor + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        if (blocks == nullptr || aligned + bytes > (uintptr_t)limit)
+        {
+            // the blocks at least double, so a hull needs O(log(n)) of them
+            add_block(std::max(blocks == nullptr ? merged_size : capacity, sizeof(Block) + bytes + alignment));
+            aligned = ((uintptr_t)cursor + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        }
+        cursor = reinterpret_cast<std::byte *>(aligned + bytes);
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    void do_deallocate(void *, size_t, size_t) override
+    {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+public:
+    /**
+     * @brief Construct a new Hull Arena object
+     *
+     * @param upstream_to_set the resource the blocks are allocated from, the heap by default
+     * @param initial_size the size of the first block
+     */
+    explicit HullArena(std::pmr::memory_resource *upstream_to_set = std::pmr::new_delete_resource(), size_t initial_size = ARENA_INITIAL_SIZE)
+        : upstream(upstream_to_set), blocks(nullptr), cursor(nullptr), limit(nullptr), capacity(0), merged_size(std::max(initial_size, 2 * sizeof(Block)))
+    {
+    }
+
+    HullArena(const HullArena &) = delete;
+    HullArena &operator=(const HullArena &) = delete;
+
+    ~HullArena()
+    {
+        release_blocks();
+    }
+
+    /**
+     * @brief Make all the memory of the arena available again, every object allocated from it must be destroyed
+     */
+    void reset()
+    {
+        if (blocks != nullptr && blocks->previous == nullptr)
+        {
+            cursor = reinterpret_cast<std::byte *>(blocks) + sizeof(Block);
+            return;
+        }
+        merged_size = std::max(merged_size, capacity);
+        release_blocks();
+        add_block(merged_size);
+    }
+
+    /**
+     * @brief Get the total size of the blocks held by the arena
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return capacity;
+    }
+};
@@ -0,0 +1,187 @@
+/**
+ * @file batch_hull.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief A batch API finding the convex hulls of many small, independent point sets stored in one flat array
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+#include "geometry.hpp"
+#include "convex_hull.hpp"
+#include "thread_pool.hpp"
+
+#define BATCH_GRAIN_SIZE 1024
+#define SMALL_HULL_SIZE 8
+#define SMALL_SORT_NETWORK_SIZE 19
+
+/**
+ * @brief The comparators of a sorting network for SMALL_HULL_SIZE elements (Batcher's odd-even merge sort), as pairs
+ * of indices; dropping the comparators that touch an index past n still sorts the first n elements
+ */
+const size_t small_sort_network[SMALL_SORT_NETWORK_SIZE][2] = {{0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {0, 1}, {2, 3}, {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6}};
+
+/**
+ * @brief The convex hulls of a batch of point sets, stored like the sets: one flat array and the offsets of every hull in it
+ */
+struct HullBatch
+{
+    /**
+     * @brief The points of every hull, one hull after the other
+     */
+    vector<Point> points;
+
+    /**
+     * @brief The hull of set i is points[offsets[i], offsets[i + 1]), so there is one more offset than hulls
+     */
+    vector<size_t> offsets;
+
+    /**
+     * @brief Get the number of hulls
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    /**
+     * @brief Get a hull, in counter-clockwise order starting from its lowest leftmost point
+     *
+     * @param i the index of its set
+     * @return std::span<const Point>
+     */
+    std::span<const Point> operator[](size_t i) const
+    {
+        return std::span<const Point>(points.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+};
+
+/**
+ * @brief Swap two points if they are out of lexicographic order, with selects instead of a branch
+ *
+ * @param a
+ * @param b
+ */
+inline void compare_exchange(Point &a, Point &b)
+{
+    bool out_of_order = b < a;
+    Point low = out_of_order ? b : a, high = out_of_order ? a : b;
+    a = low;
+    b = high;
+}
+
+/**
+ * @brief Find the convex hull of at most SMALL_HULL_SIZE points without touching the heap
+ * the points are sorted on the stack with a sorting network and their hull is built with monotone chain
+ *
+ * @param points the points of the set
+ * @param count the number of points, at most SMALL_HULL_SIZE
+ * @param hull output, with room for count points
+ * @return size_t the number of hull points written to hull, in counter-clockwise order starting from the lowest leftmost point
+ */
+size_t small_convex_hull(const Point *points, size_t count, Point *hull)
+{
+    Point sorted[SMALL_HULL_SIZE], chain[2 * SMALL_HULL_SIZE];
+    copy(points, points + count, sorted);
+    for (const size_t *comparator : small_sort_network)
+    {
+        if (comparator[1] < count)
+        {
+            compare_exchange(sorted[comparator[0]], sorted[comparator[1]]);
+        }
+    }
+    size_t distinct = (size_t)(unique(sorted, sorted + count) - sorted);
+    size_t hull_size = build_monotone_chain(sorted, distinct, chain);
+    copy(chain, chain + hull_size, hull);
+    return hull_size;
+}
+
+/**
+ * @brief Find the convex hull of a set of points of any size, with a scratch buffer reused from one set to the next
+ * the larger sets are hulled with the in-place Quickhull, which runs in linear time on most sets, unlike sorting them
+ *
+ * @param points the points of the set
+ * @param count the number of points
+ * @param hull output, with room for count points
+ * @param scratch the buffer the in-place Quickhull runs in
+ * @return size_t the number of hull points written to hull, in counter-clockwise order starting from the lowest leftmost point
+ */
+size_t set_convex_hull(const Point *points, size_t count, Point *hull, vector<Point> &scratch)
+{
+    if (count <= SMALL_HULL_SIZE)
+    {
+        return small_convex_hull(points, count, hull);
+    }
+    // the scratch buffer is moved through the engine and back, so its memory is reused
+    scratch.assign(points, points + count);
+    scratch = quick_hull_in_place(std::move(scratch));
+    copy(scratch.begin(), scratch.end(), hull);
+    return scratch.size();
+}
+
+/**
+ * @brief A function to find the convex hulls of a batch of independent point sets, in parallel
+ * the sets are split into contiguous chunks; every chunk writes its hulls one after the other into the part of the
+ * output that its sets span, which is always large enough, with a scratch buffer allocated once per chunk, and the
+ * chunks are then moved together, so finding a hull never allocates
+ *
+ * @param points the points of every set, one set after the other
+ * @param offsets set i is points[offsets[i], offsets[i + 1]), so there is one more offset than sets
+ * @param hulls output, the hull of every set
+ * @param pool the pool finding the hulls
+ * @param grain_size the minimum number of sets in a chunk
+ * @return true if the hulls were found
+ * @return false if the offsets are empty, decreasing, or past the end of the points
+ */
+bool batch_convex_hull(std::span<const Point> points, std::span<const size_t> offsets, HullBatch &hulls, ThreadPool &pool = default_thread_pool(), size_t grain_size = BATCH_GRAIN_SIZE)
+{
+    hulls.points.clear();
+    hulls.offsets.clear();
+    if (offsets.empty() || offsets.back() > points.size() || !is_sorted(offsets.begin(), offsets.end()))
+    {
+        return false;
+    }
+
+    size_t set_count = offsets.size() - 1, first_offset = offsets.front();
+    hulls.points.resize(offsets.back() - first_offset);
+    hulls.offsets.resize(offsets.size());
+    size_t chunk_count = parallel_chunk_count(pool, set_count, grain_size);
+    vector<size_t> chunk_begins(chunk_count), chunk_ends(chunk_count), chunk_sizes(chunk_count);
+    parallel_chunks(pool, 0, set_count, chunk_count, [&](size_t chunk, size_t chunk_begin, size_t chunk_end)
+                    {
+        Point *output = hulls.points.data() + (offsets[chunk_begin] - first_offset);
+        vector<Point> scratch;
+        size_t written = 0;
+        for (size_t i = chunk_begin; i < chunk_end; i++)
+        {
+            hulls.offsets[i] = written;
+            written += set_convex_hull(points.data() + offsets[i], offsets[i + 1] - offsets[i], output + written, scratch);
+        }
+        chunk_begins[chunk] = chunk_begin;
+        chunk_ends[chunk] = chunk_end;
+        chunk_sizes[chunk] = written; });
+
+    // every chunk moves towards the front, in order, so it never overwrites a chunk that is still to be moved
+    size_t total = 0;
+    for (size_t chunk = 0; chunk < chunk_count; chunk++)
+    {
+        size_t source = offsets[chunk_begins[chunk]] - first_offset;
+        move(hulls.points.begin() + (ptrdiff_t)source, hulls.points.begin() + (ptrdiff_t)(source + chunk_sizes[chunk]), hulls.points.begin() + (ptrdiff_t)total);
+        for (size_t i = chunk_begins[chunk]; i < chunk_ends[chunk]; i++)
+        {
+            hulls.offsets[i] += total;
+        }
+        total += chunk_sizes[chunk];
+    }
+    hulls.offsets[set_count] = total;
+    hulls.points.resize(total);
+    return true;
+}
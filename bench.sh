@@ -0,0 +1,2 @@
+g++ ./bench/bench.cpp -O2 -Wall -Wextra -Wconversion -Wsign-conversion -Wshadow -Wpedantic -std=c++20 -pthread -o ./bench/bench.out
+./bench/bench.out "$@"
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "../approximate_hull.hpp"
+#include "../convex_hull.hpp"
+#include "../generator.hpp"
+
+/**
+ * @brief Time the approximate hull against quick_hull on one input, printing the median latency of both
+ * the error is the largest distance from a point to the approximate hull, measured once, next to its bound
+ *
+ * @param n the number of points
+ * @param distribution the distribution of the points
+ * @param strip_count the number of strips of the approximate hull
+ * @param repetitions the number of timed runs of each
+ */
+void bench_approximate_hull(size_t n, PointDistribution distribution, size_t strip_count, size_t repetitions)
+{
+    std::vector<Point> points = generate_points(n, distribution, 42);
+    std::vector<double> approximate_seconds, exact_seconds;
+    ApproximateHull approximate;
+    std::vector<Point> exact;
+    for (size_t i = 0; i < repetitions; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        approximate = approximate_hull(points, strip_count);
+        approximate_seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+        start = std::chrono::steady_clock::now();
+        exact = quick_hull(points);
+        exact_seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    sort(approximate_seconds.begin(), approximate_seconds.end());
+    sort(exact_seconds.begin(), exact_seconds.end());
+    double approximate_median = approximate_seconds[repetitions / 2], exact_median = exact_seconds[repetitions / 2];
+
+    // every point of the exact hull is within the error of the approximate one, so its vertices give the error
+    double error = 0;
+    for (Point p : exact)
+    {
+        size_t h = approximate.hull.size();
+        for (size_t i = 0; i < h && h >= 3; i++)
+        {
+            Point a = approximate.hull[i], b = approximate.hull[(i + 1) % h];
+            error = max(error, -orient2d(a, b, p) / a.distance_to(b));
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(2) << std::setw(12) << n << std::setw(8) << strip_count
+              << std::setw(14) << 1e6 * approximate_median << std::setw(16) << 1e6 * exact_median
+              << std::setw(10) << exact_median / approximate_median << "x"
+              << std::setw(10) << approximate.hull.size() << std::setw(8) << exact.size()
+              << std::scientific << std::setprecision(1) << std::setw(11) << error << std::setw(11) << approximate.error_bound << std::endl;
+}
+
+void bench_approximate_hulls()
+{
+    std::cout << "Approximate hull against quick_hull, median latency on uniform disk points:" << std::endl;
+    std::cout << std::setw(12) << "points" << std::setw(8) << "strips" << std::setw(14) << "approx (us)" << std::setw(16) << "quick_hull (us)"
+              << std::setw(11) << "speedup" << std::setw(10) << "vertices" << std::setw(8) << "exact" << std::setw(11) << "error" << std::setw(11) << "bound" << std::endl;
+    for (size_t n : {(size_t)10000, (size_t)100000, (size_t)1000000, (size_t)10000000})
+    {
+        for (size_t strip_count : {(size_t)64, (size_t)APPROXIMATE_STRIP_COUNT, (size_t)4096})
+        {
+            bench_approximate_hull(n, PointDistribution::UNIFORM_DISK, strip_count, n >= 10000000 ? 3 : 11);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "engines.bench.hpp"
+#include "dynamic_hull.bench.hpp"
+#include "approximate_hull.bench.hpp"
+
+/**
+ * @brief Run the benchmarks
+ * usage: bench.out [engines|dynamic|approximate] [--min-n N] [--max-n N] [--warmup W] [--repetitions R] [--time-limit S] [--json PATH] [--csv PATH]
+ * without a benchmark name, all of them are run
+ *
+ * @param argc
+ * @param argv
+ * @return int
+ */
+int main(int argc, char **argv)
+{
+    EngineBenchOptions options;
+    bool run_engines = true, run_dynamic = true, run_approximate = true;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument == "engines" || argument == "dynamic" || argument == "approximate")
+        {
+            run_engines = argument == "engines";
+            run_dynamic = argument == "dynamic";
+            run_approximate = argument == "approximate";
+        }
+        else if (i + 1 < argc && argument == "--min-n")
+        {
+            options.min_n = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (i + 1 < argc && argument == "--max-n")
+        {
+            options.max_n = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (i + 1 < argc && argument == "--warmup")
+        {
+            options.warmup = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (i + 1 < argc && argument == "--repetitions")
+        {
+            options.repetitions = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (i + 1 < argc && argument == "--time-limit")
+        {
+            options.time_limit = std::strtod(argv[++i], nullptr);
+        }
+        else if (i + 1 < argc && argument == "--json")
+        {
+            options.json_path = argv[++i];
+        }
+        else if (i + 1 < argc && argument == "--csv")
+        {
+            options.csv_path = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Unknown argument " << argument << std::endl;
+            return 1;
+        }
+    }
+    options.min_n = std::max(options.min_n, (size_t)1);
+
+    if (run_engines)
+    {
+        bench_hull_engines(options);
+    }
+    if (run_dynamic)
+    {
+        bench_dynamic_hulls();
+    }
+    if (run_approximate)
+    {
+        bench_approximate_hulls();
+    }
+}
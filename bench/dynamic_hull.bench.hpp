@@ -0,0 +1,109 @@
+#pragma once
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../convex_hull.hpp"
+#include "../dynamic_hull.hpp"
+
+/**
+ * @brief An update of the benchmark workload
+ */
+struct HullUpdate
+{
+    bool erase;
+    Point p;
+    size_t index;
+};
+
+/**
+ * @brief Run a mixed workload of insertions and deletions, querying the hull after every update
+ * the same updates are replayed on a DynamicHull and on a vector of points whose hull is recomputed with quick_hull, and
+ * the average time of one update plus query is printed for both
+ *
+ * @param alive the number of points alive at any time
+ * @param operations the number of updates, alternating between deleting a random alive point and inserting a new one
+ */
+void bench_dynamic_hull(size_t alive, size_t operations)
+{
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> coordinate(0, 1);
+    std::vector<Point> points;
+    for (size_t i = 0; i < alive; i++)
+    {
+        points.push_back(Point(coordinate(random), coordinate(random)));
+    }
+
+    std::vector<HullUpdate> updates;
+    std::vector<Point> live = points;
+    for (size_t i = 0; i < operations; i++)
+    {
+        if (i % 2 == 0)
+        {
+            size_t index = random() % live.size();
+            updates.push_back(HullUpdate{true, live[index], index});
+            live[index] = live.back();
+            live.pop_back();
+        }
+        else
+        {
+            Point p(coordinate(random), coordinate(random));
+            updates.push_back(HullUpdate{false, p, live.size()});
+            live.push_back(p);
+        }
+    }
+
+    DynamicHull dynamic(points);
+    size_t dynamic_vertices = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const HullUpdate &update : updates)
+    {
+        if (update.erase)
+        {
+            dynamic.erase(update.p);
+        }
+        else
+        {
+            dynamic.insert(update.p);
+        }
+        dynamic_vertices += dynamic.hull().size();
+    }
+    double dynamic_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    live = points;
+    size_t recompute_vertices = 0;
+    start = std::chrono::steady_clock::now();
+    for (const HullUpdate &update : updates)
+    {
+        if (update.erase)
+        {
+            live[update.index] = live.back();
+            live.pop_back();
+        }
+        else
+        {
+            live.push_back(update.p);
+        }
+        recompute_vertices += quick_hull(live).size();
+    }
+    double recompute_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(2) << std::setw(10) << alive << std::setw(10) << operations
+              << std::setw(16) << 1e6 * dynamic_seconds / (double)operations
+              << std::setw(18) << 1e6 * recompute_seconds / (double)operations
+              << std::setw(10) << recompute_seconds / dynamic_seconds << "x"
+              << (dynamic_vertices == recompute_vertices ? "" : "  (hull sizes differ)") << std::endl;
+}
+
+void bench_dynamic_hulls()
+{
+    std::cout << "Dynamic hull against recomputing quick_hull, per update and query:" << std::endl;
+    std::cout << std::setw(10) << "alive" << std::setw(10) << "updates"
+              << std::setw(16) << "dynamic (us)" << std::setw(18) << "quick_hull (us)" << std::setw(11) << "speedup" << std::endl;
+    bench_dynamic_hull(1000, 20000);
+    bench_dynamic_hull(10000, 4000);
+    bench_dynamic_hull(100000, 400);
+    bench_dynamic_hull(1000000, 40);
+}
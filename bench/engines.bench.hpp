@@ -0,0 +1,358 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include <unistd.h>
+#include "../convex_hull.hpp"
+#include "../generator.hpp"
+
+#define BENCH_SEED 42
+#define BENCH_MEMORY_FACTOR 6
+
+/**
+ * @brief The settings of the engine benchmark, set from the command line
+ */
+struct EngineBenchOptions
+{
+    size_t min_n = 1000, max_n = 100000000;
+    size_t warmup = 1, repetitions = 5;
+
+    /**
+     * @brief A run predicted to take longer than this, in seconds, is skipped, along with the larger sizes of its engine and distribution
+     */
+    double time_limit = 5;
+
+    std::string json_path, csv_path;
+};
+
+/**
+ * @brief The measurements of one engine on one input
+ */
+struct EngineBenchResult
+{
+    std::string engine, distribution;
+    size_t n = 0, repetitions = 0, hull_size = 0;
+    double median_seconds = 0, p99_seconds = 0;
+    uint64_t peak_rss_bytes = 0;
+
+    /**
+     * @brief "ok", or why the case was skipped
+     */
+    std::string status = "ok";
+
+    double points_per_second() const
+    {
+        return median_seconds > 0 ? (double)n / median_seconds : 0;
+    }
+};
+
+/**
+ * @brief An engine under benchmark: a function timing one run on a copy of the points and storing the size of the hull
+ */
+struct BenchEngine
+{
+    std::string name;
+    std::function<double(const std::vector<Point> &, size_t &)> run;
+};
+
+/**
+ * @brief Time one run of an engine, the input is built by the caller so copying it is not timed
+ *
+ * @tparam Input the type the engine takes
+ * @tparam Engine a function from Input to the hull
+ * @param input
+ * @param engine
+ * @param hull_size output, the number of vertices of the hull
+ * @return double the time taken, in seconds
+ */
+template <typename Input, typename Engine>
+double time_engine(Input input, Engine engine, size_t &hull_size)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<Point> hull = engine(std::move(input));
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    hull_size = hull.size();
+    return seconds;
+}
+
+std::vector<BenchEngine> bench_engines()
+{
+    return {
+        {"gift_wrapping", [](const std::vector<Point> &points, size_t &hull_size)
+         { return time_engine(points, gift_wrapping<double>, hull_size); }},
+        {"quick_hull", [](const std::vector<Point> &points, size_t &hull_size)
+         { return time_engine(points, [](const std::vector<Point> &input)
+                              { return quick_hull(input); },
+                              hull_size); }},
+        {"quick_hull_in_place", [](const std::vector<Point> &points, size_t &hull_size)
+         { return time_engine(points, quick_hull_in_place<double>, hull_size); }},
+        {"quick_hull_soa", [](const std::vector<Point> &points, size_t &hull_size)
+         { return time_engine(PointBuffer(points), quick_hull_soa, hull_size); }},
+        {"quick_hull_parallel", [](const std::vector<Point> &points, size_t &hull_size)
+         { return time_engine(points, [](std::vector<Point> input)
+                              { return quick_hull_parallel(std::move(input)); },
+                              hull_size); }},
+        {"monotone_chain", [](const std::vector<Point> &points, size_t &hull_size)
+         { return time_engine(points, monotone_chain<double>, hull_size); }},
+        {"chan", [](const std::vector<Point> &points, size_t &hull_size)
+         { return time_engine(points, chan, hull_size); }},
+        {"convex_hull", [](const std::vector<Point> &points, size_t &hull_size)
+         { return time_engine(points, [](std::vector<Point> input)
+                              { return convex_hull(std::move(input)); },
+                              hull_size); }},
+        {"convex_hull_prefilter", [](const std::vector<Point> &points, size_t &hull_size)
+         { return time_engine(points, [](std::vector<Point> input)
+                              {
+                                  HullOptions options;
+                                  options.prefilter = true;
+                                  return convex_hull(std::move(input), options); },
+                              hull_size); }},
+    };
+}
+
+std::vector<std::pair<std::string, PointDistribution>> bench_distributions()
+{
+    return {
+        {"uniform_square", PointDistribution::UNIFORM_SQUARE},
+        {"uniform_disk", PointDistribution::UNIFORM_DISK},
+        {"circle", PointDistribution::CIRCLE},
+        {"gaussian", PointDistribution::GAUSSIAN},
+        {"clustered", PointDistribution::CLUSTERED},
+        {"duplicates", PointDistribution::DUPLICATES},
+        {"collinear", PointDistribution::COLLINEAR},
+    };
+}
+
+/**
+ * @brief Forget the peak resident set size measured so far, so that the next reading only covers what follows
+ * only supported on Linux, elsewhere the peak covers the whole process; the memory freed by the previous cases is first
+ * given back to the system, so it does not count
+ */
+void reset_peak_rss()
+{
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+    FILE *clear_refs = fopen("/proc/self/clear_refs", "w");
+    if (clear_refs != nullptr)
+    {
+        fputs("5", clear_refs);
+        fclose(clear_refs);
+    }
+}
+
+/**
+ * @brief Get the peak resident set size since the last reset_peak_rss
+ *
+ * @return uint64_t in bytes
+ */
+uint64_t peak_rss()
+{
+    FILE *status = fopen("/proc/self/status", "r");
+    if (status != nullptr)
+    {
+        char line[256];
+        unsigned long long kilobytes = 0;
+        while (fgets(line, sizeof(line), status) != nullptr)
+        {
+            if (sscanf(line, "VmHWM: %llu kB", &kilobytes) == 1)
+            {
+                fclose(status);
+                return 1024ull * kilobytes;
+            }
+        }
+        fclose(status);
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return 1024ull * (uint64_t)usage.ru_maxrss;
+}
+
+/**
+ * @brief Get the memory that can be used without swapping
+ *
+ * @return uint64_t in bytes
+ */
+uint64_t available_memory()
+{
+    return (uint64_t)sysconf(_SC_AVPHYS_PAGES) * (uint64_t)sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief Get a percentile of a set of timings, with the nearest-rank method
+ *
+ * @param sorted the timings, in increasing order
+ * @param percentile in (0, 100]
+ * @return double
+ */
+double percentile_of(const std::vector<double> &sorted, double percentile)
+{
+    size_t rank = (size_t)std::ceil(percentile / 100 * (double)sorted.size());
+    return sorted[std::max(rank, (size_t)1) - 1];
+}
+
+/**
+ * @brief Measure one engine on one input: the warm-up runs are discarded, then the repetitions are timed
+ *
+ * @param engine
+ * @param points
+ * @param options
+ * @param result where the measurements are stored
+ */
+void bench_engine(const BenchEngine &engine, const std::vector<Point> &points, const EngineBenchOptions &options, EngineBenchResult &result)
+{
+    size_t hull_size = 0;
+    reset_peak_rss();
+    for (size_t i = 0; i < options.warmup; i++)
+    {
+        engine.run(points, hull_size);
+    }
+    std::vector<double> timings;
+    for (size_t i = 0; i < std::max(options.repetitions, (size_t)1); i++)
+    {
+        timings.push_back(engine.run(points, hull_size));
+    }
+    std::sort(timings.begin(), timings.end());
+    result.repetitions = timings.size();
+    result.hull_size = hull_size;
+    result.median_seconds = timings.size() % 2 == 1 ? timings[timings.size() / 2] : (timings[timings.size() / 2 - 1] + timings[timings.size() / 2]) / 2;
+    result.p99_seconds = percentile_of(timings, 99);
+    result.peak_rss_bytes = peak_rss();
+}
+
+/**
+ * @brief Predict the time of a run at a larger size from the last two sizes measured
+ * the growth is assumed to be between linear and quadratic, following the growth seen so far
+ *
+ * @param previous the results of the engine on the distribution so far
+ * @param n the next size
+ * @return double in seconds
+ */
+double predict_seconds(const std::vector<EngineBenchResult> &previous, size_t n)
+{
+    const EngineBenchResult &last = previous.back();
+    double exponent = 1;
+    if (previous.size() >= 2 && previous[previous.size() - 2].median_seconds > 0)
+    {
+        const EngineBenchResult &before = previous[previous.size() - 2];
+        exponent = std::log(last.median_seconds / before.median_seconds) / std::log((double)last.n / (double)before.n);
+        exponent = std::clamp(exponent, 1.0, 2.0);
+    }
+    return last.median_seconds * std::pow((double)n / (double)last.n, exponent);
+}
+
+void write_bench_json(const std::vector<EngineBenchResult> &results, const std::string &path)
+{
+    std::ofstream file(path);
+    file << "[\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const EngineBenchResult &result = results[i];
+        file << "  {\"engine\": \"" << result.engine << "\", \"distribution\": \"" << result.distribution << "\", \"n\": " << result.n
+             << ", \"status\": \"" << result.status << "\", \"repetitions\": " << result.repetitions
+             << ", \"median_seconds\": " << std::setprecision(9) << result.median_seconds << ", \"p99_seconds\": " << result.p99_seconds
+             << ", \"points_per_second\": " << std::setprecision(6) << result.points_per_second() << ", \"hull_size\": " << result.hull_size
+             << ", \"peak_rss_bytes\": " << result.peak_rss_bytes << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "]\n";
+}
+
+void write_bench_csv(const std::vector<EngineBenchResult> &results, const std::string &path)
+{
+    std::ofstream file(path);
+    file << "engine,distribution,n,status,repetitions,median_seconds,p99_seconds,points_per_second,hull_size,peak_rss_bytes\n";
+    for (const EngineBenchResult &result : results)
+    {
+        file << result.engine << "," << result.distribution << "," << result.n << "," << result.status << "," << result.repetitions << ","
+             << std::setprecision(9) << result.median_seconds << "," << result.p99_seconds << "," << std::setprecision(6) << result.points_per_second() << ","
+             << result.hull_size << "," << result.peak_rss_bytes << "\n";
+    }
+}
+
+void print_bench_result(const EngineBenchResult &result)
+{
+    std::cout << std::setw(24) << result.engine << std::setw(16) << result.distribution << std::setw(11) << result.n;
+    if (result.status != "ok")
+    {
+        std::cout << "  skipped: " << result.status << std::endl;
+        return;
+    }
+    std::cout << std::fixed << std::setprecision(3) << std::setw(13) << 1e3 * result.median_seconds << std::setw(13) << 1e3 * result.p99_seconds
+              << std::setprecision(2) << std::setw(11) << result.points_per_second() / 1e6 << std::setw(10) << result.hull_size
+              << std::setw(10) << (double)result.peak_rss_bytes / (1 << 20) << std::defaultfloat << std::endl;
+}
+
+/**
+ * @brief Run every engine over every distribution and every power of ten between options.min_n and options.max_n
+ * a case is skipped when it is predicted to be slower than options.time_limit, or when its input would not fit in memory
+ *
+ * @param options
+ * @return std::vector<EngineBenchResult> the results, also printed and written to the requested files
+ */
+std::vector<EngineBenchResult> bench_hull_engines(const EngineBenchOptions &options)
+{
+    std::vector<BenchEngine> engines = bench_engines();
+    std::vector<EngineBenchResult> results;
+    std::cout << "Hull engines, median of " << options.repetitions << " runs after " << options.warmup << " warm-up runs:" << std::endl;
+    std::cout << std::setw(24) << "engine" << std::setw(16) << "distribution" << std::setw(11) << "n"
+              << std::setw(13) << "median (ms)" << std::setw(13) << "p99 (ms)" << std::setw(11) << "Mpoints/s"
+              << std::setw(10) << "hull" << std::setw(10) << "RSS (MB)" << std::endl;
+
+    for (const std::pair<std::string, PointDistribution> &distribution : bench_distributions())
+    {
+        std::vector<std::vector<EngineBenchResult>> measured(engines.size());
+        for (size_t n = options.min_n; n <= options.max_n; n *= 10)
+        {
+            bool fits = (uint64_t)n * sizeof(Point) * BENCH_MEMORY_FACTOR <= available_memory();
+            std::vector<Point> points;
+            if (fits)
+            {
+                points = generate_points(n, distribution.second, BENCH_SEED);
+            }
+            for (size_t e = 0; e < engines.size(); e++)
+            {
+                EngineBenchResult result;
+                result.engine = engines[e].name;
+                result.distribution = distribution.first;
+                result.n = n;
+                if (!fits)
+                {
+                    result.status = "not enough memory";
+                }
+                else if (!measured[e].empty() && (measured[e].back().status != "ok" || predict_seconds(measured[e], n) > options.time_limit))
+                {
+                    result.status = "over the time limit";
+                }
+                else
+                {
+                    bench_engine(engines[e], points, options, result);
+                }
+                measured[e].push_back(result);
+                results.push_back(result);
+                print_bench_result(result);
+            }
+        }
+    }
+
+    if (!options.json_path.empty())
+    {
+        write_bench_json(results, options.json_path);
+    }
+    if (!options.csv_path.empty())
+    {
+        write_bench_csv(results, options.csv_path);
+    }
+    return results;
+}
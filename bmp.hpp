@@ -10,7 +10,13 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
 #include <string>
+#include <vector>
+#include "framebuffer.hpp"
 #include "utils.hpp"
 
 using namespace std;
@@ -20,6 +26,8 @@ using namespace std;
 #define WHITE "FFFFFF"
 #define BLACK "000000"
 #define RED "0000FF"
+#define BMP_BYTES_PER_PIXEL 3
+#define BMP_WRITE_BUFFER_SIZE (1 << 20)
 
 // following https://en.wikipedia.org/wiki/BMP_file_format guide for creating BMP
 /**
@@ -37,6 +45,17 @@ uint64_t calculate_file_size(uint64_t width, uint64_t height)
     return data_size + BMP_HEADER_SIZE + DIB_HEADER_SIZE;
 }
 
+/**
+ * @brief Get the number of bytes of a row of the bitmap image, including the padding
+ *
+ * @param width
+ * @return uint64_t
+ */
+uint64_t calculate_row_size(uint64_t width)
+{
+    return (BMP_BYTES_PER_PIXEL * width + 3) / 4 * 4;
+}
+
 /**
  * @brief Create a bitmap file header object
  *
@@ -152,4 +171,238 @@ void create_bmp_file_from_hex(std::string image, char *filename)
     image_file = fopen(filename, "wb");
     fwrite(binary.c_str(), sizeof(char), binary.length(), image_file);
     fclose(image_file);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Write an unsigned integer as little-endian bytes
+ *
+ * @param bytes where the bytes are written
+ * @param value
+ * @param count the number of bytes
+ */
+void write_little_endian(uint8_t *bytes, uint64_t value, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        bytes[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+/**
+ * @brief Write the bitmap file header and the DIB header, the binary counterparts of create_bitmap_file_header and create_dib_header
+ *
+ * @param headers where the BMP_HEADER_SIZE + DIB_HEADER_SIZE bytes are written
+ * @param width
+ * @param height
+ */
+void write_bmp_headers(uint8_t *headers, uint64_t width, uint64_t height)
+{
+    std::fill(headers, headers + BMP_HEADER_SIZE + DIB_HEADER_SIZE, 0);
+    headers[0] = 'B';
+    headers[1] = 'M';
+    write_little_endian(headers + 2, calculate_file_size(width, height), 4);
+    write_little_endian(headers + 10, BMP_HEADER_SIZE + DIB_HEADER_SIZE, 4);
+
+    uint8_t *dib_header = headers + BMP_HEADER_SIZE;
+    write_little_endian(dib_header, DIB_HEADER_SIZE, 4);
+    write_little_endian(dib_header + 4, width, 4);
+    write_little_endian(dib_header + 8, height, 4);
+    // one color plane, 24 bits per pixel, no compression
+    write_little_endian(dib_header + 12, 1, 2);
+    write_little_endian(dib_header + 14, 8 * BMP_BYTES_PER_PIXEL, 2);
+    write_little_endian(dib_header + 20, calculate_row_size(width) * height, 4);
+}
+
+/**
+ * @brief Write the color of a value of an image array as a pixel, in blue, green, red order
+ * 1 is black, 2 is red, and everything else is white
+ *
+ * @param value
+ * @param pixel where the 3 bytes are written
+ */
+void write_pixel(double value, uint8_t *pixel)
+{
+    uint8_t blue = 0xFF, green = 0xFF, red = 0xFF;
+    if (value == 1)
+    {
+        blue = green = red = 0;
+    }
+    else if (value == 2)
+    {
+        blue = green = 0;
+    }
+    pixel[0] = blue;
+    pixel[1] = green;
+    pixel[2] = red;
+}
+
+/**
+ * @brief Encode a bitmap image into a byte buffer
+ * the buffer is only grown, so encoding images of the same size into the same buffer allocates once
+ *
+ * @tparam FillRow a function (row, pixels) writing the 3 * width bytes of a row, bottom row first
+ * @param width
+ * @param height
+ * @param fill_row
+ * @param buffer the output, resized to the size of the file
+ */
+template <typename FillRow>
+void encode_bmp(uint64_t width, uint64_t height, FillRow fill_row, std::vector<uint8_t> &buffer)
+{
+    uint64_t row_size = calculate_row_size(width);
+    buffer.resize(calculate_file_size(width, height));
+    write_bmp_headers(buffer.data(), width, height);
+    for (uint64_t i = 0; i < height; i++)
+    {
+        uint8_t *row = buffer.data() + BMP_HEADER_SIZE + DIB_HEADER_SIZE + i * row_size;
+        fill_row(i, row);
+        std::fill(row + BMP_BYTES_PER_PIXEL * width, row + row_size, 0);
+    }
+}
+
+/**
+ * @brief Stream a bitmap image to a file
+ * the rows are encoded in batches of about BMP_WRITE_BUFFER_SIZE bytes into one reused buffer, so the memory used does
+ * not depend on the height of the image and every fwrite is large
+ *
+ * @tparam FillRow a function (row, pixels) writing the 3 * width bytes of a row, bottom row first
+ * @param file a file opened for binary writing
+ * @param width
+ * @param height
+ * @param fill_row
+ * @return true if the whole image was written
+ * @return false otherwise
+ */
+template <typename FillRow>
+bool write_bmp(FILE *file, uint64_t width, uint64_t height, FillRow fill_row)
+{
+    uint8_t headers[BMP_HEADER_SIZE + DIB_HEADER_SIZE];
+    write_bmp_headers(headers, width, height);
+    if (fwrite(headers, 1, sizeof(headers), file) != sizeof(headers))
+    {
+        return false;
+    }
+
+    uint64_t row_size = calculate_row_size(width);
+    uint64_t rows_per_batch = std::max((uint64_t)1, (uint64_t)BMP_WRITE_BUFFER_SIZE / std::max(row_size, (uint64_t)1));
+    std::vector<uint8_t> batch(row_size * std::min(rows_per_batch, height));
+    for (uint64_t first = 0; first < height; first += rows_per_batch)
+    {
+        uint64_t rows = std::min(rows_per_batch, height - first);
+        for (uint64_t i = 0; i < rows; i++)
+        {
+            uint8_t *row = batch.data() + i * row_size;
+            fill_row(first + i, row);
+            std::fill(row + BMP_BYTES_PER_PIXEL * width, row + row_size, 0);
+        }
+        if (fwrite(batch.data(), 1, rows * row_size, file) != rows * row_size)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Encode an image array into a byte buffer, without going through a hex string
+ *
+ * @param image_array
+ * @param width
+ * @param height
+ * @param buffer the output, resized to the size of the file
+ */
+void encode_bmp(double **image_array, uint64_t width, uint64_t height, std::vector<uint8_t> &buffer)
+{
+    encode_bmp(width, height, [image_array, width](uint64_t i, uint8_t *row)
+               {
+        for (uint64_t j = 0; j < width; j++)
+        {
+            write_pixel(image_array[i][j], row + BMP_BYTES_PER_PIXEL * j);
+        } },
+               buffer);
+}
+
+/**
+ * @brief Create a bmp file from an image array, streaming the binary rows straight to the file
+ *
+ * @param image_array
+ * @param width
+ * @param height
+ * @param filename
+ * @return true if the file was written
+ * @return false otherwise
+ */
+bool create_bmp_file_from_image_array(double **image_array, uint64_t width, uint64_t height, const char *filename)
+{
+    FILE *image_file = fopen(filename, "wb");
+    if (image_file == nullptr)
+    {
+        return false;
+    }
+    bool written = write_bmp(image_file, width, height, [image_array, width](uint64_t i, uint8_t *row)
+                             {
+        for (uint64_t j = 0; j < width; j++)
+        {
+            write_pixel(image_array[i][j], row + BMP_BYTES_PER_PIXEL * j);
+        } });
+    return fclose(image_file) == 0 && written;
+}
+
+/**
+ * @brief Build a function writing the rows of a framebuffer, looking every palette index up in a table of its pixel bytes
+ *
+ * @param framebuffer
+ * @return a function (row, pixels) for encode_bmp and write_bmp
+ */
+auto framebuffer_row_filler(const Framebuffer &framebuffer)
+{
+    std::array<uint8_t, BMP_BYTES_PER_PIXEL * PALETTE_SIZE> pixels;
+    for (size_t index = 0; index < PALETTE_SIZE; index++)
+    {
+        Color color = framebuffer.get_color((uint8_t)index);
+        pixels[BMP_BYTES_PER_PIXEL * index] = color.blue;
+        pixels[BMP_BYTES_PER_PIXEL * index + 1] = color.green;
+        pixels[BMP_BYTES_PER_PIXEL * index + 2] = color.red;
+    }
+    return [&framebuffer, pixels](uint64_t i, uint8_t *row)
+    {
+        const uint8_t *indices = framebuffer.row(i);
+        for (uint64_t j = 0; j < framebuffer.get_width(); j++)
+        {
+            const uint8_t *pixel = pixels.data() + BMP_BYTES_PER_PIXEL * indices[j];
+            row[BMP_BYTES_PER_PIXEL * j] = pixel[0];
+            row[BMP_BYTES_PER_PIXEL * j + 1] = pixel[1];
+            row[BMP_BYTES_PER_PIXEL * j + 2] = pixel[2];
+        }
+    };
+}
+
+/**
+ * @brief Encode a framebuffer into a byte buffer
+ *
+ * @param framebuffer
+ * @param buffer the output, resized to the size of the file
+ */
+void encode_bmp(const Framebuffer &framebuffer, std::vector<uint8_t> &buffer)
+{
+    encode_bmp(framebuffer.get_width(), framebuffer.get_height(), framebuffer_row_filler(framebuffer), buffer);
+}
+
+/**
+ * @brief Create a bmp file from a framebuffer, streaming the binary rows straight to the file
+ *
+ * @param framebuffer
+ * @param filename
+ * @return true if the file was written
+ * @return false otherwise
+ */
+bool create_bmp_file_from_framebuffer(const Framebuffer &framebuffer, const char *filename)
+{
+    FILE *image_file = fopen(filename, "wb");
+    if (image_file == nullptr)
+    {
+        return false;
+    }
+    bool written = write_bmp(image_file, framebuffer.get_width(), framebuffer.get_height(), framebuffer_row_filler(framebuffer));
+    return fclose(image_file) == 0 && written;
+}
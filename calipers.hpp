@@ -0,0 +1,360 @@
+/**
+ * @file calipers.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief Rotating calipers over a convex hull: its diameter, its width and its minimum enclosing rectangles, in O(h)
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <cmath>
+#include <span>
+#include <vector>
+#include "geometry.hpp"
+#include "batch_hull.hpp"
+#include "thread_pool.hpp"
+
+#define CALIPERS_GRAIN_SIZE 1024
+
+/**
+ * @brief Two points and the squared distance between them
+ */
+struct PointPair
+{
+    Point first, second;
+    double squared_distance = 0;
+
+    /**
+     * @brief Get the distance between the two points
+     *
+     * @return double
+     */
+    double distance() const
+    {
+        return sqrt(squared_distance);
+    }
+};
+
+/**
+ * @brief A rectangle enclosing a hull, with one side along an edge of the hull
+ */
+struct EnclosingRectangle
+{
+    /**
+     * @brief The corners, in counter-clockwise order starting from the one on the edge that comes first along the edge
+     */
+    Point corners[4];
+
+    /**
+     * @brief The length of the sides along the edge, and of the sides across it
+     */
+    double width = 0, height = 0;
+
+    /**
+     * @brief Get the area of the rectangle
+     *
+     * @return double
+     */
+    double area() const
+    {
+        return width * height;
+    }
+
+    /**
+     * @brief Get the perimeter of the rectangle
+     *
+     * @return double
+     */
+    double perimeter() const
+    {
+        return 2 * (width + height);
+    }
+};
+
+/**
+ * @brief The dot product of two vectors given by their coordinates
+ *
+ * @param ax
+ * @param ay
+ * @param bx
+ * @param by
+ * @return double
+ */
+inline double dot_product(double ax, double ay, double bx, double by)
+{
+    return ax * bx + ay * by;
+}
+
+/**
+ * @brief The squared distance between two points
+ *
+ * @param a
+ * @param b
+ * @return double
+ */
+inline double squared_distance(Point a, Point b)
+{
+    double dx = b.get_x() - a.get_x(), dy = b.get_y() - a.get_y();
+    return dx * dx + dy * dy;
+}
+
+/**
+ * @brief Find the diameter of a hull, its farthest pair of points, with rotating calipers in O(h)
+ * for every edge, the vertex farthest from it moves forward around the hull, and the farthest pair is one of these
+ * antipodal pairs; the distances are compared squared, so the loop takes no square root
+ *
+ * @param hull the vertices of the hull, in counter-clockwise order without collinear vertices, as returned by any engine
+ * @return PointPair the farthest pair, with a distance of zero if the hull is empty or a single point
+ */
+PointPair hull_diameter(std::span<const Point> hull)
+{
+    PointPair diameter;
+    size_t h = hull.size();
+    if (h == 0)
+    {
+        return diameter;
+    }
+    diameter.first = hull[0];
+    diameter.second = hull[0];
+    for (size_t i = 0, j = 1 % h; i < h; i++)
+    {
+        Point a = hull[i], b = hull[(i + 1) % h];
+        while (cross_product(a, b, hull[(j + 1) % h]) > cross_product(a, b, hull[j]))
+        {
+            j = (j + 1) % h;
+        }
+        for (Point p : {a, b})
+        {
+            double distance = squared_distance(p, hull[j]);
+            if (distance > diameter.squared_distance)
+            {
+                diameter = {p, hull[j], distance};
+            }
+        }
+    }
+    return diameter;
+}
+
+/**
+ * @brief Find the width of a hull, the smallest distance between two parallel lines enclosing it, in O(h)
+ * the width is always reached with one of the lines along an edge, so it is the smallest distance from an edge to its
+ * farthest vertex; these are compared squared, so the loop takes no square root
+ *
+ * @param hull the vertices of the hull, in counter-clockwise order without collinear vertices, as returned by any engine
+ * @return double the width, zero if the hull has less than three vertices
+ */
+double hull_width(std::span<const Point> hull)
+{
+    size_t h = hull.size();
+    if (h < 3)
+    {
+        return 0;
+    }
+    double squared_width = INFINITY;
+    for (size_t i = 0, j = 1; i < h; i++)
+    {
+        Point a = hull[i], b = hull[(i + 1) % h];
+        while (cross_product(a, b, hull[(j + 1) % h]) > cross_product(a, b, hull[j]))
+        {
+            j = (j + 1) % h;
+        }
+        double height = cross_product(a, b, hull[j]);
+        squared_width = min(squared_width, height * height / squared_distance(a, b));
+    }
+    return sqrt(squared_width);
+}
+
+/**
+ * @brief Find the enclosing rectangle of a hull with one side along an edge, minimizing a cost, with rotating calipers
+ * in O(h); for every edge, the three other sides touch the vertices that are the farthest forward along the edge, away
+ * from it and backward along it, and the three move forward around the hull as the edge does. The cost is given the
+ * sides scaled by the length of the edge, so the loop takes no square root
+ *
+ * @tparam Cost a function of (width, height, squared length of the edge), where the sides are scaled by the length of
+ * the edge, returning a double that is smaller for a better rectangle
+ * @param hull the vertices of the hull, in counter-clockwise order without collinear vertices, as returned by any engine
+ * @param cost
+ * @return EnclosingRectangle the rectangle with the smallest cost, with all corners on the point if the hull is a single point
+ */
+template <typename Cost>
+EnclosingRectangle minimum_enclosing_rectangle(std::span<const Point> hull, Cost cost)
+{
+    EnclosingRectangle rectangle;
+    size_t h = hull.size();
+    if (h < 2)
+    {
+        for (Point &corner : rectangle.corners)
+        {
+            corner = h == 0 ? Point() : hull[0];
+        }
+        return rectangle;
+    }
+
+    auto along = [&](size_t edge, size_t vertex)
+    {
+        Point a = hull[edge], b = hull[(edge + 1) % h];
+        return dot_product(b.get_x() - a.get_x(), b.get_y() - a.get_y(), hull[vertex].get_x() - a.get_x(), hull[vertex].get_y() - a.get_y());
+    };
+    auto across = [&](size_t edge, size_t vertex)
+    {
+        return cross_product(hull[edge], hull[(edge + 1) % h], hull[vertex]);
+    };
+
+    double best_cost = INFINITY;
+    size_t best_edge = 0, best_forward = 0, best_top = 0, best_backward = 0;
+    for (size_t i = 0, forward = 1, top = 1, backward = 1; i < h; i++)
+    {
+        while (along(i, (forward + 1) % h) > along(i, forward))
+        {
+            forward = (forward + 1) % h;
+        }
+        // on the first edge, the vertex away from the edge and the one backward along it come after the one forward
+        if (i == 0)
+        {
+            top = forward;
+        }
+        while (across(i, (top + 1) % h) > across(i, top))
+        {
+            top = (top + 1) % h;
+        }
+        if (i == 0)
+        {
+            backward = top;
+        }
+        while (along(i, (backward + 1) % h) < along(i, backward))
+        {
+            backward = (backward + 1) % h;
+        }
+
+        double rectangle_cost = cost(along(i, forward) - along(i, backward), across(i, top), squared_distance(hull[i], hull[(i + 1) % h]));
+        if (rectangle_cost < best_cost)
+        {
+            best_cost = rectangle_cost;
+            best_edge = i;
+            best_forward = forward;
+            best_top = top;
+            best_backward = backward;
+        }
+    }
+
+    // the corners, from the edge and the distances along and across it in units of its squared length
+    Point a = hull[best_edge], b = hull[(best_edge + 1) % h];
+    double dx = b.get_x() - a.get_x(), dy = b.get_y() - a.get_y(), squared_length = dx * dx + dy * dy;
+    double backward_along = along(best_edge, best_backward) / squared_length, forward_along = along(best_edge, best_forward) / squared_length;
+    double top_across = across(best_edge, best_top) / squared_length;
+    auto corner = [&](double s, double t)
+    {
+        return Point(a.get_x() + s * dx - t * dy, a.get_y() + s * dy + t * dx);
+    };
+    rectangle.corners[0] = corner(backward_along, 0);
+    rectangle.corners[1] = corner(forward_along, 0);
+    rectangle.corners[2] = corner(forward_along, top_across);
+    rectangle.corners[3] = corner(backward_along, top_across);
+    double length = sqrt(squared_length);
+    rectangle.width = (forward_along - backward_along) * length;
+    rectangle.height = top_across * length;
+    return rectangle;
+}
+
+/**
+ * @brief Find the enclosing rectangle of a hull with the smallest area, in O(h)
+ *
+ * @param hull the vertices of the hull, in counter-clockwise order without collinear vertices, as returned by any engine
+ * @return EnclosingRectangle
+ */
+EnclosingRectangle minimum_area_rectangle(std::span<const Point> hull)
+{
+    return minimum_enclosing_rectangle(hull, [](double width, double height, double squared_length)
+                                       { return width * height / squared_length; });
+}
+
+/**
+ * @brief Find the enclosing rectangle of a hull with the smallest perimeter, in O(h)
+ *
+ * @param hull the vertices of the hull, in counter-clockwise order without collinear vertices, as returned by any engine
+ * @return EnclosingRectangle
+ */
+EnclosingRectangle minimum_perimeter_rectangle(std::span<const Point> hull)
+{
+    // the squared half perimeter, which needs no square root
+    return minimum_enclosing_rectangle(hull, [](double width, double height, double squared_length)
+                                       { return (width + height) * (width + height) / squared_length; });
+}
+
+/**
+ * @brief Measure every hull of a batch in parallel
+ *
+ * @tparam Result
+ * @tparam Measure a function of a hull returning a Result
+ * @param hulls
+ * @param results output, resized to the number of hulls
+ * @param measure
+ * @param pool the pool measuring the hulls
+ * @param grain_size the minimum number of hulls in a chunk
+ */
+template <typename Result, typename Measure>
+void measure_hulls(const HullBatch &hulls, vector<Result> &results, Measure measure, ThreadPool &pool, size_t grain_size)
+{
+    results.resize(hulls.size());
+    parallel_chunks(pool, 0, hulls.size(), parallel_chunk_count(pool, hulls.size(), grain_size), [&](size_t, size_t chunk_begin, size_t chunk_end)
+                    {
+        for (size_t i = chunk_begin; i < chunk_end; i++)
+        {
+            results[i] = measure(hulls[i]);
+        } });
+}
+
+/**
+ * @brief Find the diameter of every hull of a batch, in parallel
+ *
+ * @param hulls
+ * @param diameters output, the diameter of every hull
+ * @param pool the pool measuring the hulls
+ * @param grain_size the minimum number of hulls in a chunk
+ */
+void hull_diameters(const HullBatch &hulls, vector<PointPair> &diameters, ThreadPool &pool = default_thread_pool(), size_t grain_size = CALIPERS_GRAIN_SIZE)
+{
+    measure_hulls(hulls, diameters, hull_diameter, pool, grain_size);
+}
+
+/**
+ * @brief Find the width of every hull of a batch, in parallel
+ *
+ * @param hulls
+ * @param widths output, the width of every hull
+ * @param pool the pool measuring the hulls
+ * @param grain_size the minimum number of hulls in a chunk
+ */
+void hull_widths(const HullBatch &hulls, vector<double> &widths, ThreadPool &pool = default_thread_pool(), size_t grain_size = CALIPERS_GRAIN_SIZE)
+{
+    measure_hulls(hulls, widths, hull_width, pool, grain_size);
+}
+
+/**
+ * @brief Find the enclosing rectangle with the smallest area of every hull of a batch, in parallel
+ *
+ * @param hulls
+ * @param rectangles output, the rectangle of every hull
+ * @param pool the pool measuring the hulls
+ * @param grain_size the minimum number of hulls in a chunk
+ */
+void minimum_area_rectangles(const HullBatch &hulls, vector<EnclosingRectangle> &rectangles, ThreadPool &pool = default_thread_pool(), size_t grain_size = CALIPERS_GRAIN_SIZE)
+{
+    measure_hulls(hulls, rectangles, minimum_area_rectangle, pool, grain_size);
+}
+
+/**
+ * @brief Find the enclosing rectangle with the smallest perimeter of every hull of a batch, in parallel
+ *
+ * @param hulls
+ * @param rectangles output, the rectangle of every hull
+ * @param pool the pool measuring the hulls
+ * @param grain_size the minimum number of hulls in a chunk
+ */
+void minimum_perimeter_rectangles(const HullBatch &hulls, vector<EnclosingRectangle> &rectangles, ThreadPool &pool = default_thread_pool(), size_t grain_size = CALIPERS_GRAIN_SIZE)
+{
+    measure_hulls(hulls, rectangles, minimum_perimeter_rectangle, pool, grain_size);
+}
@@ -1,6 +1,7 @@
 /**
  * @file convex_hull.hpp
- * @brief A file to implement the gift wrapping and Quickhull algorithm to find the convex hull of a set of points
+ * @brief A file to implement the gift wrapping, Quickhull, monotone chain and Chan's algorithms to find the convex hull of a set of points
+ * every engine returns the hull in counter-clockwise order starting from the lowest leftmost point, without collinear vertices
  * @author Yassaman Ommi (ommiy@mcmaster.ca)
  * @version 0.1
  * @date 2023-01-02
@@ -15,71 +16,109 @@
 #include <vector>
 #include <limits>
 #include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include "arena.hpp"
 #include "geometry.hpp"
+#include "point_buffer.hpp"
+#include "kernels.hpp"
+#include "prefilter.hpp"
+#include "thread_pool.hpp"
 
 using namespace std;
 
 #define INF_DOUBLE std::numeric_limits<double>::infinity()
+#define HULL_SAMPLE_SIZE 256
+#define QUICKHULL_GRAIN_SIZE 65536
+
+/**
+ * @brief The convex hull engines that can be selected through convex_hull
+ */
+enum class Algorithm
+{
+    AUTOMATIC,
+    GIFT_WRAPPING,
+    QUICK_HULL,
+    PARALLEL_QUICK_HULL,
+    MONOTONE_CHAIN,
+    CHAN
+};
+
+/**
+ * @brief The options of convex_hull
+ */
+struct HullOptions
+{
+    /**
+     * @brief The engine to use
+     */
+    Algorithm algorithm = Algorithm::AUTOMATIC;
+
+    /**
+     * @brief Whether to discard the points inside the Akl-Toussaint octagon before running the engine
+     */
+    bool prefilter = false;
+
+    /**
+     * @brief If not null, the number of points the engine ran on (the survivors of the prefilter) is written to it
+     */
+    size_t *survivors = nullptr;
+
+    /**
+     * @brief Whether to keep the points lying on the edges of the hull as vertices, every engine drops them otherwise
+     */
+    bool keep_collinear = false;
+};
 
 /**
  * @brief A function to find the convex hull of a set of points using the gift wrapping algorithm
+ * starting from the lowest leftmost point, the hull is wrapped by repeatedly picking the point that has every other point on its left
  *
+ * @tparam T the type of the coordinates, the turns are exact for integer coordinates
+ * @tparam Allocator the allocator of the points, which the hull is allocated with
  * @param points given set of points
- * @return vector<Point> a vector of points that form the convex hull
+ * @return vector<BasicPoint<T>, Allocator> a vector of points that form the convex hull, in counter-clockwise order starting from the lowest leftmost point
  */
-vector<Point> gift_wrapping(vector<Point> points)
+template <typename T, typename Allocator = std::allocator<BasicPoint<T>>>
+vector<BasicPoint<T>, Allocator> gift_wrapping(vector<BasicPoint<T>, Allocator> points)
 {
-    vector<Point> hull;
-    Point start = points[0], previous, current, next;
-    double max_slope = -INF_DOUBLE, max_dot = -1;
-
-    for (vector<Point>::iterator it = points.begin(); it != points.end(); it++)
+    vector<BasicPoint<T>, Allocator> hull(points.get_allocator());
+    if (points.empty())
     {
-        Point point = (Point)*it;
-        if (point.get_x() < start.get_x() || (point.get_x() == start.get_x() && point.get_y() < start.get_y()))
-        {
-            start = point;
-        }
+        return hull;
     }
 
-    hull.push_back(start);
-    previous = start;
-
-    for (vector<Point>::iterator it = points.begin(); it != points.end(); it++)
+    BasicPoint<T> start = *min_element(points.begin(), points.end()), current = start;
+    // a hull has at most n points, which also stops the wrapping if rounding errors ever make it miss the start
+    for (size_t step = 0; step < points.size(); step++)
     {
-        Point point = (Point)*it;
-        if (point == previous)
-        {
-            continue;
-        }
-        double slope = (point.get_y() - previous.get_y()) / abs(point.get_x() - previous.get_x());
-        if (slope > max_slope)
-        {
-            max_slope = slope;
-            current = point;
-        }
-    }
+        hull.push_back(current);
 
-    while (current != *hull.begin())
-    {
-        max_dot = -1;
-        for (vector<Point>::iterator it = points.begin(); it != points.end(); it++)
+        // keep the most clockwise candidate, and the farthest one among collinear candidates
+        BasicPoint<T> next = current;
+        for (typename vector<BasicPoint<T>, Allocator>::iterator it = points.begin(); it != points.end(); it++)
         {
-            Point point = (Point)*it;
+            BasicPoint<T> point = *it;
             if (point == current)
             {
                 continue;
             }
-            double dot_product = Line(previous, current) * Line(current, point);
-            if (dot_product > max_dot)
+            auto turn = orient2d(current, next, point);
+            if (next == current || turn < 0 || (turn == 0 && current.distance_to(point) > current.distance_to(next)))
             {
-                max_dot = dot_product;
                 next = point;
             }
         }
-        previous = current;
+
+        if (next == current || next == start)
+        {
+            break;
+        }
         current = next;
-        hull.push_back(current);
     }
 
     return hull;
@@ -90,163 +129,1323 @@ vector<Point> gift_wrapping(vector<Point> points)
  *
  * @param points the set of remaining points
  * @param base the line to use for eliminating and choosing the points
- * @return vector<Point>
+ * @param hull output, the hull points outside the base line are appended to it in order from its start to its end; the
+ * scratch vectors are allocated from its memory resource
  */
-vector<Point> find_hull(vector<Point> points, Line base)
+void find_hull(std::span<const Point> points, Line base, std::pmr::vector<Point> &hull)
 {
     if (points.empty())
     {
-        return points;
+        return;
     }
-    vector<Point> left_points;
-    for (vector<Point>::iterator it = points.begin(); it != points.end(); it++)
+    // the sides are those of is_point_on_left_of_line, computed with the batch kernels of kernels.hpp; the ends of the
+    // base line are on it, so they are never kept
+    std::pmr::vector<Point> left_points(hull.get_allocator());
+    for_each_side(points.data(), points.size(), base, [&points, &left_points](size_t i, int8_t side)
+                  {
+        if (side < 0)
+        {
+            left_points.push_back(points[i]);
+        } });
+    if (left_points.empty())
     {
-        Point point = (Point)*it;
-        if (point == base.get_start() || point == base.get_end())
+        return;
+    }
+
+    // the points are on the right of the base line, that is on the left of its reverse; among points at the same
+    // distance, the lexicographically smallest is an end of their segment, so it is a vertex
+    Point farthest = left_points[farthest_point(left_points.data(), left_points.size(), base.get_end(), base.get_start())];
+
+    // every point outside the triangle goes to one side only, so that no point is reported twice when rounding made the
+    // farthest point slightly off
+    std::pmr::vector<Point> first_outside(hull.get_allocator()), second_outside(hull.get_allocator());
+    Line first_line = Line(base.get_start(), farthest), second_line = Line(farthest, base.get_end());
+    for_each_side(left_points.data(), left_points.size(), first_line, second_line, [&](size_t i, int8_t first_side, int8_t second_side)
+                  {
+        if (first_side < 0)
         {
-            continue;
+            first_outside.push_back(left_points[i]);
         }
-        if (base.is_point_on_left_of_line(point))
+        else if (second_side < 0)
         {
-            left_points.push_back(point);
-        }
-    }
+            second_outside.push_back(left_points[i]);
+        } });
+
+    find_hull(first_outside, first_line, hull);
+    hull.push_back(farthest);
+    find_hull(second_outside, second_line, hull);
+}
 
-    double max_dist = -INF_DOUBLE;
-    Point farthest;
-    for (vector<Point>::iterator it = left_points.begin(); it != left_points.end(); it++)
+/**
+ * @brief Remove the vertices of a nearly convex polygon that do not make a strict counter-clockwise turn
+ * Quickhull picks its farthest points by comparing rounded cross products, so among points that are almost equally far it
+ * can pick one that is not a vertex; the exact turns of orient2d find those in one pass, in O(h)
+ *
+ * @tparam T the type of the coordinates
+ * @tparam Allocator the allocator of the polygon
+ * @param hull a polygon in counter-clockwise order starting from the lowest leftmost point, shrunk to its convex vertices
+ */
+template <typename T, typename Allocator>
+void remove_reflex_vertices(vector<BasicPoint<T>, Allocator> &hull)
+{
+    size_t k = 0;
+    for (size_t i = 0; i < hull.size(); i++)
     {
-        Point point = (Point)*it;
-        if (base.distance_from_point(point) > max_dist)
+        while (k >= 2 && orient2d(hull[k - 2], hull[k - 1], hull[i]) <= 0)
         {
-            farthest = point;
-            max_dist = base.distance_from_point(point);
+            k--;
         }
+        hull[k++] = hull[i];
+    }
+    while (k >= 3 && orient2d(hull[k - 2], hull[k - 1], hull[0]) <= 0)
+    {
+        k--;
     }
+    hull.resize(k);
+}
 
-    vector<Point> outside_triangle;
-    Line first_line = Line(base.get_start(), farthest), second_line = Line(farthest, base.get_end());
+/**
+ * @brief A function to find the convex hull of a set of points using the Quickhull algorithm, allocating from a memory resource
+ * the hull and every scratch vector of the recursion are allocated from the resource, so with a HullArena that is reset
+ * between calls, repeated hulls stop allocating from the heap
+ *
+ * @param points given set of points
+ * @param resource the memory resource to allocate from
+ * @return std::pmr::vector<Point> a vector of points that form the convex hull, in counter-clockwise order starting from the lowest leftmost point
+ */
+std::pmr::vector<Point> quick_hull(std::span<const Point> points, std::pmr::memory_resource *resource)
+{
+    std::pmr::vector<Point> hull(resource);
+    if (points.empty())
+    {
+        return hull;
+    }
+    Point leftest = points[0], rightest = points[0];
 
-    for (vector<Point>::iterator it = left_points.begin(); it != left_points.end(); it++)
+    for (std::span<const Point>::iterator it = points.begin(); it != points.end(); it++)
     {
         Point point = (Point)*it;
-        if (point == farthest)
+        if (point.get_x() < leftest.get_x() || (point.get_x() == leftest.get_x() && point.get_y() < leftest.get_y()))
         {
-            continue;
+            leftest = point;
         }
-        if (first_line.is_point_on_left_of_line(point) || second_line.is_point_on_left_of_line(point))
+
+        if (point.get_x() > rightest.get_x() || (point.get_x() == rightest.get_x() && point.get_y() > rightest.get_y()))
         {
-            outside_triangle.push_back(point);
+            rightest = point;
         }
     }
 
-    vector<Point> first_hull = find_hull(outside_triangle, first_line);
-    vector<Point> second_hull = find_hull(outside_triangle, second_line);
-    vector<Point> merged_hull;
-    if (farthest != Point())
+    if (leftest == rightest)
     {
-        merged_hull.push_back(farthest);
+        hull.push_back(leftest);
+        return hull;
     }
-    merged_hull.insert(merged_hull.end(), first_hull.begin(), first_hull.end());
-    merged_hull.insert(merged_hull.end(), second_hull.begin(), second_hull.end());
 
-    return merged_hull;
+    Line left_right_line = Line(leftest, rightest);
+    std::pmr::vector<Point> left_points(resource);
+    std::pmr::vector<Point> right_points(resource);
+
+    for_each_side(points.data(), points.size(), left_right_line, [&](size_t i, int8_t side)
+                  {
+        if (side < 0)
+        {
+            left_points.push_back(points[i]);
+        }
+        else if (points[i] != leftest && points[i] != rightest)
+        {
+            right_points.push_back(points[i]);
+        } });
+
+    // the points on the left of the line, as seen by is_point_on_left_of_line, are below it, so the left hull is the lower one
+    hull.push_back(leftest);
+    find_hull(left_points, left_right_line, hull);
+    hull.push_back(rightest);
+    find_hull(right_points, left_right_line.reversed_line(), hull);
+    remove_reflex_vertices(hull);
+    return hull;
 }
 
 /**
  * @brief A function to find the convex hull of a set of points using the Quickhull algorithm
  *
  * @param points given set of points
- * @return vector<Point> a vector of points that form the convex hull
+ * @return vector<Point> a vector of points that form the convex hull, in counter-clockwise order starting from the lowest leftmost point
  */
-vector<Point> quick_hull(vector<Point> points)
+vector<Point> quick_hull(const vector<Point> &points)
 {
-    vector<Point> hull;
-    Point leftest = points[0], rightest = points[0];
+    std::pmr::vector<Point> hull = quick_hull(std::span<const Point>(points), std::pmr::get_default_resource());
+    return vector<Point>(hull.begin(), hull.end());
+}
+
+/**
+ * @brief Move the points of buffer[begin, end) that are on the right of the start->finish line to the front of the span
+ * double coordinates are classified with the batch kernels of kernels.hpp, and integer ones with orient2d
+ *
+ * @tparam T the type of the coordinates
+ * @tparam Allocator the allocator of the buffer
+ * @param buffer the buffer holding the points
+ * @param begin the first index of the span
+ * @param end one past the last index of the span
+ * @param start start point of the line
+ * @param finish end point of the line
+ * @return size_t one past the index of the last point on the right of the line
+ */
+template <typename T, typename Allocator>
+size_t partition_right_of_line(vector<BasicPoint<T>, Allocator> &buffer, size_t begin, size_t end, BasicPoint<T> start, BasicPoint<T> finish)
+{
+    if constexpr (std::is_same_v<T, double>)
+    {
+        // a forward partition only swaps the current point with one that is already classified
+        size_t kept = begin;
+        for_each_side(buffer.data() + begin, end - begin, Line(start, finish), [&buffer, &kept, begin](size_t i, int8_t side)
+                      {
+            if (side < 0)
+            {
+                swap(buffer[kept++], buffer[begin + i]);
+            } });
+        return kept;
+    }
+    else
+    {
+        return (size_t)(partition(buffer.begin() + (ptrdiff_t)begin, buffer.begin() + (ptrdiff_t)end, [start, finish](BasicPoint<T> p)
+                                  { return orient2d(start, finish, p) < 0; }) -
+                        buffer.begin());
+    }
+}
 
-    for (vector<Point>::iterator it = points.begin(); it != points.end(); it++)
+/**
+ * @brief A helper function for the in-place Quickhull algorithm that finds the hull of the points in buffer[begin, end)
+ * all the points in the span must be on the right of the start->finish line, and they are partitioned in place
+ * instead of being copied into new vectors
+ *
+ * @tparam T the type of the coordinates
+ * @tparam Allocator the allocator of the buffer
+ * @param buffer the buffer holding the points
+ * @param begin the first index of the span
+ * @param end one past the last index of the span
+ * @param start start point of the base line
+ * @param finish end point of the base line
+ * @return size_t the number of hull points, which are written in order from start to finish to buffer[begin, begin + count)
+ */
+template <typename T, typename Allocator>
+size_t find_hull_in_place(vector<BasicPoint<T>, Allocator> &buffer, size_t begin, size_t end, BasicPoint<T> start, BasicPoint<T> finish)
+{
+    if (begin == end)
     {
-        Point point = (Point)*it;
-        if (point.get_x() < leftest.get_x() || (point.get_x() == leftest.get_x() && point.get_y() < leftest.get_y()))
+        return 0;
+    }
+
+    // the cross product is proportional to the distance from the base line, so no sqrt is needed.
+    // among points at the same distance, the lexicographically smallest is an end of their segment, so it is a vertex
+    size_t farthest_index = begin;
+    if constexpr (std::is_same_v<T, double>)
+    {
+        // the points are on the right of start->finish, that is on the left of finish->start
+        farthest_index += farthest_point(buffer.data() + begin, end - begin, finish, start);
+    }
+    else
+    {
+        auto min_cross = cross_product(start, finish, buffer[begin]);
+        for (size_t i = begin + 1; i < end; i++)
         {
-            leftest = point;
+            auto cross = cross_product(start, finish, buffer[i]);
+            if (cross < min_cross || (cross == min_cross && buffer[i] < buffer[farthest_index]))
+            {
+                min_cross = cross;
+                farthest_index = i;
+            }
         }
+    }
+    BasicPoint<T> farthest = buffer[farthest_index];
 
-        if (point.get_x() > rightest.get_x() || (point.get_x() == rightest.get_x() && point.get_y() > rightest.get_y()))
+    // layout after partitioning: [outside start->farthest][farthest][outside farthest->finish][inside the triangle]
+    swap(buffer[farthest_index], buffer[end - 1]);
+    size_t first_end = partition_right_of_line(buffer, begin, end - 1, start, farthest);
+    swap(buffer[first_end], buffer[end - 1]);
+    size_t second_begin = first_end + 1;
+    size_t second_end = partition_right_of_line(buffer, second_begin, end, farthest, finish);
+
+    // the sub-hulls are compacted towards begin, which never overwrites a span that is still needed
+    size_t first_count = find_hull_in_place(buffer, begin, first_end, start, farthest);
+    buffer[begin + first_count] = farthest;
+    size_t second_count = find_hull_in_place(buffer, second_begin, second_end, farthest, finish);
+    move(buffer.begin() + (ptrdiff_t)second_begin, buffer.begin() + (ptrdiff_t)(second_begin + second_count), buffer.begin() + (ptrdiff_t)(begin + first_count + 1));
+
+    return first_count + 1 + second_count;
+}
+
+/**
+ * @brief A function to find the convex hull of a set of points using an in-place, index-based Quickhull algorithm
+ * the given vector is the only buffer used: every subproblem is a [begin, end) span of it, so no heap allocation happens after the copy of the input
+ *
+ * @tparam T the type of the coordinates, the turns are exact for integer coordinates
+ * @tparam Allocator the allocator of the points, whose buffer becomes the hull
+ * @param points given set of points
+ * @return vector<BasicPoint<T>, Allocator> a vector of points that form the convex hull, in counter-clockwise order starting from the lowest leftmost point
+ */
+template <typename T, typename Allocator = std::allocator<BasicPoint<T>>>
+vector<BasicPoint<T>, Allocator> quick_hull_in_place(vector<BasicPoint<T>, Allocator> points)
+{
+    if (points.empty())
+    {
+        return points;
+    }
+
+    size_t leftest_index = 0, rightest_index = 0;
+    for (size_t i = 1; i < points.size(); i++)
+    {
+        if (points[i] < points[leftest_index])
         {
-            rightest = point;
+            leftest_index = i;
+        }
+        if (points[rightest_index] < points[i])
+        {
+            rightest_index = i;
         }
     }
+    BasicPoint<T> leftest = points[leftest_index], rightest = points[rightest_index];
+    if (leftest == rightest)
+    {
+        points.resize(1);
+        return points;
+    }
 
-    Line left_right_line = Line(leftest, rightest);
-    vector<Point> left_points;
-    vector<Point> right_points;
+    // layout after partitioning: [leftest][rightest][below the line][above the line][the rest]
+    swap(points[0], points[leftest_index]);
+    swap(points[1], points[rightest_index == 0 ? leftest_index : rightest_index]);
+    size_t lower_end = partition_right_of_line(points, 2, points.size(), leftest, rightest);
+    size_t upper_end = partition_right_of_line(points, lower_end, points.size(), rightest, leftest);
 
-    for (vector<Point>::iterator it = points.begin(); it != points.end(); it++)
+    size_t lower_count = find_hull_in_place(points, 2, lower_end, leftest, rightest);
+    move(points.begin() + 2, points.begin() + 2 + (ptrdiff_t)lower_count, points.begin() + 1);
+    points[1 + lower_count] = rightest;
+    size_t upper_count = find_hull_in_place(points, lower_end, upper_end, rightest, leftest);
+    move(points.begin() + (ptrdiff_t)lower_end, points.begin() + (ptrdiff_t)(lower_end + upper_count), points.begin() + (ptrdiff_t)(2 + lower_count));
+
+    points.resize(2 + lower_count + upper_count);
+    remove_reflex_vertices(points);
+    return points;
+}
+
+/**
+ * @brief Move the points of buffer[begin, end) whose side is positive to the front of the span
+ *
+ * @param buffer the buffer holding the points
+ * @param sides the sides computed by classify_points, indexed like the buffer
+ * @param begin the first index of the span
+ * @param end one past the last index of the span
+ * @return size_t one past the index of the last point with a positive side
+ */
+size_t partition_by_side(PointBuffer &buffer, vector<int8_t> &sides, size_t begin, size_t end)
+{
+    while (true)
     {
-        Point point = (Point)*it;
-        if (point == leftest || point == rightest)
+        while (begin < end && sides[begin] > 0)
         {
-            continue;
+            begin++;
         }
-        if (left_right_line.is_point_on_left_of_line(point))
+        while (begin < end && sides[end - 1] <= 0)
         {
-            left_points.push_back(point);
+            end--;
         }
-        else
+        if (begin == end)
         {
-            right_points.push_back(point);
+            return begin;
         }
+        buffer.swap_points(begin, end - 1);
+        swap(sides[begin], sides[end - 1]);
     }
+}
 
-    vector<Point> left_hull = find_hull(left_points, left_right_line);
-    vector<Point> right_hull = find_hull(right_points, left_right_line.reversed_line());
-    vector<Point> merged_hull;
-    merged_hull.push_back(leftest);
-    merged_hull.push_back(rightest);
-    merged_hull.insert(merged_hull.end(), left_hull.begin(), left_hull.end());
-    merged_hull.insert(merged_hull.end(), right_hull.begin(), right_hull.end());
-    return merged_hull;
+/**
+ * @brief Move count points of a buffer from index source to index destination, which must not be after source
+ *
+ * @param buffer the buffer holding the points
+ * @param source
+ * @param count
+ * @param destination
+ */
+void move_points(PointBuffer &buffer, size_t source, size_t count, size_t destination)
+{
+    copy(buffer.x() + source, buffer.x() + source + count, buffer.x() + destination);
+    copy(buffer.y() + source, buffer.y() + source + count, buffer.y() + destination);
 }
 
 /**
- * @brief Gets the set of lines that form the convex hull / connect the points of the convex hull
+ * @brief A helper function for the structure-of-arrays Quickhull algorithm, the counterpart of find_hull_in_place
+ * the farthest point and the sides of the points are computed with the batch kernels of kernels.hpp
  *
- * @param convex_hull a set of points that form the convex hull
- * @return vector<Line>
+ * @param buffer the buffer holding the points
+ * @param sides a buffer of the same size used for partitioning
+ * @param begin the first index of the span
+ * @param end one past the last index of the span
+ * @param start start point of the base line
+ * @param finish end point of the base line
+ * @return size_t the number of hull points, which are written in order from start to finish to buffer[begin, begin + count)
  */
-vector<Line> get_convex_hull_lines(vector<Point> convex_hull)
+size_t find_hull_soa(PointBuffer &buffer, vector<int8_t> &sides, size_t begin, size_t end, Point start, Point finish)
 {
-    vector<Line> hull_lines;
+    if (begin == end)
+    {
+        return 0;
+    }
+
+    // the points are on the right of start->finish, that is on the left of finish->start
+    size_t farthest_index = begin + farthest_point(buffer.x() + begin, buffer.y() + begin, end - begin, finish, start);
+    Point farthest = buffer.get(farthest_index);
+
+    buffer.swap_points(farthest_index, end - 1);
+    classify_points(buffer.x() + begin, buffer.y() + begin, end - 1 - begin, farthest, start, sides.data() + begin);
+    size_t first_end = partition_by_side(buffer, sides, begin, end - 1);
+    buffer.swap_points(first_end, end - 1);
+    size_t second_begin = first_end + 1;
+    classify_points(buffer.x() + second_begin, buffer.y() + second_begin, end - second_begin, finish, farthest, sides.data() + second_begin);
+    size_t second_end = partition_by_side(buffer, sides, second_begin, end);
+
+    size_t first_count = find_hull_soa(buffer, sides, begin, first_end, start, farthest);
+    buffer.set(begin + first_count, farthest);
+    size_t second_count = find_hull_soa(buffer, sides, second_begin, second_end, farthest, finish);
+    move_points(buffer, second_begin, second_count, begin + first_count + 1);
+
+    return first_count + 1 + second_count;
+}
+
+/**
+ * @brief A function to find the convex hull of a set of points stored as structure-of-arrays, using the in-place Quickhull algorithm
+ * the partitioning and farthest point scans run on the vectorized kernels of kernels.hpp
+ *
+ * @param points given set of points
+ * @return vector<Point> a vector of points that form the convex hull, in counter-clockwise order starting from the lowest leftmost point
+ */
+vector<Point> quick_hull_soa(PointBuffer points)
+{
+    if (points.empty())
+    {
+        return vector<Point>();
+    }
 
-    for (vector<Point>::iterator it1 = convex_hull.begin(); it1 != convex_hull.end(); it1++)
+    size_t leftest_index = 0, rightest_index = 0;
+    for (size_t i = 1; i < points.size(); i++)
     {
-        Point p1 = (Point)*it1;
-        for (vector<Point>::iterator it2 = convex_hull.begin(); it2 != convex_hull.end(); it2++)
+        if (points.get(i) < points.get(leftest_index))
         {
-            Point p2 = (Point)*it2;
-            if (p1 == p2)
-            {
-                continue;
-            }
-            bool all_on_right = true;
-            Line p12_line = Line(p1, p2);
-            for (vector<Point>::iterator it3 = convex_hull.begin(); it3 != convex_hull.end(); it3++)
+            leftest_index = i;
+        }
+        if (points.get(rightest_index) < points.get(i))
+        {
+            rightest_index = i;
+        }
+    }
+    Point leftest = points.get(leftest_index), rightest = points.get(rightest_index);
+    if (leftest == rightest)
+    {
+        return vector<Point>(1, leftest);
+    }
+
+    // layout after partitioning: [leftest][rightest][below the line][above the line][the rest]
+    size_t n = points.size();
+    vector<int8_t> sides(n);
+    points.swap_points(0, leftest_index);
+    points.swap_points(1, rightest_index == 0 ? leftest_index : rightest_index);
+    classify_points(points.x() + 2, points.y() + 2, n - 2, rightest, leftest, sides.data() + 2);
+    size_t lower_end = partition_by_side(points, sides, 2, n);
+    classify_points(points.x() + lower_end, points.y() + lower_end, n - lower_end, leftest, rightest, sides.data() + lower_end);
+    size_t upper_end = partition_by_side(points, sides, lower_end, n);
+
+    size_t lower_count = find_hull_soa(points, sides, 2, lower_end, leftest, rightest);
+    size_t upper_count = find_hull_soa(points, sides, lower_end, upper_end, rightest, leftest);
+
+    vector<Point> hull;
+    hull.reserve(2 + lower_count + upper_count);
+    hull.push_back(leftest);
+    for (size_t i = 0; i < lower_count; i++)
+    {
+        hull.push_back(points.get(2 + i));
+    }
+    hull.push_back(rightest);
+    for (size_t i = 0; i < upper_count; i++)
+    {
+        hull.push_back(points.get(lower_end + i));
+    }
+    remove_reflex_vertices(hull);
+    return hull;
+}
+
+/**
+ * @brief Find the point of buffer[begin, end) that is farthest on the right of the start->finish line, with a parallel reduction over chunks
+ *
+ * @param buffer the buffer holding the points
+ * @param begin the first index of the span
+ * @param end one past the last index of the span
+ * @param start start point of the base line
+ * @param finish end point of the base line
+ * @param pool the pool running the chunks
+ * @param grain_size the minimum number of points in a chunk
+ * @return size_t the index of the farthest point
+ */
+size_t parallel_farthest_point(vector<Point> &buffer, size_t begin, size_t end, Point start, Point finish, ThreadPool &pool, size_t grain_size)
+{
+    size_t chunk_count = parallel_chunk_count(pool, end - begin, grain_size);
+    vector<size_t> farthest(chunk_count, begin);
+    vector<double> max_cross(chunk_count, -INF_DOUBLE);
+
+    // the points are on the right of start->finish, that is on the left of finish->start
+    parallel_chunks(pool, begin, end, chunk_count, [&](size_t chunk, size_t chunk_begin, size_t chunk_end)
+                    { farthest[chunk] = chunk_begin + farthest_point(buffer.data() + chunk_begin, chunk_end - chunk_begin, finish, start, &max_cross[chunk]); });
+
+    size_t best = 0;
+    for (size_t chunk = 1; chunk < chunk_count; chunk++)
+    {
+        if (max_cross[chunk] > max_cross[best] || (max_cross[chunk] == max_cross[best] && buffer[farthest[chunk]] < buffer[farthest[best]]))
+        {
+            best = chunk;
+        }
+    }
+    return farthest[best];
+}
+
+/**
+ * @brief Partition buffer[begin, end) into three classes in parallel, through a scratch buffer: the points on the right
+ * of the first line, then the points on the right of the second line, then the others
+ * every chunk labels and counts its points with the batch kernels of kernels.hpp, then scatters them to their final place
+ * in scratch, which is copied back; the output layout is [class 0][gap][class 1][class 2] starting at begin
+ *
+ * @param buffer the buffer holding the points
+ * @param scratch a buffer of the same size used for scattering
+ * @param labels a buffer of the same size holding the classes
+ * @param begin the first index of the span
+ * @param end one past the last index of the span
+ * @param gap the number of free slots left between class 0 and class 1
+ * @param first the line of class 0
+ * @param second the line of class 1
+ * @param pool the pool running the chunks
+ * @param grain_size the minimum number of points in a chunk
+ * @return pair<size_t, size_t> the sizes of class 0 and class 1
+ */
+pair<size_t, size_t> parallel_partition(vector<Point> &buffer, vector<Point> &scratch, vector<uint8_t> &labels, size_t begin, size_t end, size_t gap, Line first, Line second, ThreadPool &pool, size_t grain_size)
+{
+    size_t chunk_count = parallel_chunk_count(pool, end - begin, grain_size);
+    vector<size_t> counts(3 * chunk_count, 0);
+
+    parallel_chunks(pool, begin, end, chunk_count, [&](size_t chunk, size_t chunk_begin, size_t chunk_end)
+                    { for_each_side(buffer.data() + chunk_begin, chunk_end - chunk_begin, first, second, [&](size_t i, int8_t first_side, int8_t second_side)
+                                    {
+            uint8_t label = first_side < 0 ? 0 : (second_side < 0 ? 1 : 2);
+            labels[chunk_begin + i] = label;
+            counts[3 * chunk + label]++; }); });
+
+    // turn the counts into the position every chunk starts writing each class at
+    size_t totals[3] = {0, 0, 0};
+    for (size_t chunk = 0; chunk < chunk_count; chunk++)
+    {
+        for (size_t label = 0; label < 3; label++)
+        {
+            size_t count = counts[3 * chunk + label];
+            counts[3 * chunk + label] = totals[label];
+            totals[label] += count;
+        }
+    }
+    size_t bases[3] = {begin, begin + totals[0] + gap, begin + totals[0] + gap + totals[1]};
+
+    parallel_chunks(pool, begin, end, chunk_count, [&](size_t chunk, size_t chunk_begin, size_t chunk_end)
+                    {
+        size_t positions[3];
+        for (size_t label = 0; label < 3; label++)
+        {
+            positions[label] = bases[label] + counts[3 * chunk + label];
+        }
+        for (size_t i = chunk_begin; i < chunk_end; i++)
+        {
+            scratch[positions[labels[i]]++] = buffer[i];
+        } });
+
+    size_t output_end = end + gap;
+    parallel_chunks(pool, begin, output_end, parallel_chunk_count(pool, output_end - begin, grain_size), [&](size_t, size_t chunk_begin, size_t chunk_end)
+                    { copy(scratch.begin() + (ptrdiff_t)chunk_begin, scratch.begin() + (ptrdiff_t)chunk_end, buffer.begin() + (ptrdiff_t)chunk_begin); });
+
+    return make_pair(totals[0], totals[1]);
+}
+
+/**
+ * @brief A helper function for the parallel Quickhull algorithm, the parallel counterpart of find_hull_in_place
+ * the two sub-hulls are forked as tasks, and spans smaller than the grain size fall back to the serial version
+ *
+ * @param buffer the buffer holding the points
+ * @param scratch a buffer of the same size used for partitioning
+ * @param labels a buffer of the same size used for partitioning
+ * @param begin the first index of the span
+ * @param end one past the last index of the span
+ * @param start start point of the base line
+ * @param finish end point of the base line
+ * @param pool the pool running the tasks
+ * @param grain_size spans smaller than this are processed serially
+ * @return size_t the number of hull points, which are written in order from start to finish to buffer[begin, begin + count)
+ */
+size_t find_hull_parallel(vector<Point> &buffer, vector<Point> &scratch, vector<uint8_t> &labels, size_t begin, size_t end, Point start, Point finish, ThreadPool &pool, size_t grain_size)
+{
+    if (end - begin < grain_size)
+    {
+        return find_hull_in_place(buffer, begin, end, start, finish);
+    }
+
+    size_t farthest_index = parallel_farthest_point(buffer, begin, end, start, finish, pool, grain_size);
+    Point farthest = buffer[farthest_index];
+
+    // the farthest point is set aside, and put back in the gap between the two outside sets
+    swap(buffer[farthest_index], buffer[end - 1]);
+    pair<size_t, size_t> sizes = parallel_partition(buffer, scratch, labels, begin, end - 1, 1, Line(start, farthest), Line(farthest, finish), pool, grain_size);
+    size_t first_end = begin + sizes.first, second_begin = first_end + 1, second_end = second_begin + sizes.second;
+
+    size_t first_count = 0, second_count = 0;
+    TaskGroup group(pool);
+    group.run([&]
+              { first_count = find_hull_parallel(buffer, scratch, labels, begin, first_end, start, farthest, pool, grain_size); });
+    second_count = find_hull_parallel(buffer, scratch, labels, second_begin, second_end, farthest, finish, pool, grain_size);
+    group.wait();
+
+    buffer[begin + first_count] = farthest;
+    move(buffer.begin() + (ptrdiff_t)second_begin, buffer.begin() + (ptrdiff_t)(second_begin + second_count), buffer.begin() + (ptrdiff_t)(begin + first_count + 1));
+
+    return first_count + 1 + second_count;
+}
+
+/**
+ * @brief A function to find the convex hull of a set of points using a parallel Quickhull algorithm
+ * the independent subproblems run as tasks on a work-stealing pool, and the farthest point and the partitioning
+ * of large spans are computed with parallel passes over chunks
+ *
+ * @param points given set of points
+ * @param pool the pool running the tasks
+ * @param grain_size spans smaller than this are processed serially
+ * @return vector<Point> a vector of points that form the convex hull, in counter-clockwise order starting from the lowest leftmost point
+ */
+vector<Point> quick_hull_parallel(vector<Point> points, ThreadPool &pool = default_thread_pool(), size_t grain_size = QUICKHULL_GRAIN_SIZE)
+{
+    if (points.size() < grain_size || points.size() < 3)
+    {
+        return quick_hull_in_place(points);
+    }
+
+    size_t chunk_count = parallel_chunk_count(pool, points.size(), grain_size);
+    vector<size_t> leftest_indices(chunk_count, 0), rightest_indices(chunk_count, 0);
+    parallel_chunks(pool, 0, points.size(), chunk_count, [&](size_t chunk, size_t chunk_begin, size_t chunk_end)
+                    {
+        size_t leftest_index = chunk_begin, rightest_index = chunk_begin;
+        for (size_t i = chunk_begin + 1; i < chunk_end; i++)
+        {
+            if (points[i] < points[leftest_index])
             {
-                Point p3 = (Point)*it3;
-                if (p1 == p3 || p2 == p3)
-                {
-                    continue;
-                }
-                all_on_right = all_on_right && p12_line.is_point_on_left_of_line(p3);
+                leftest_index = i;
             }
-            if (all_on_right)
+            if (points[rightest_index] < points[i])
             {
-                hull_lines.push_back(p12_line);
-                break;
+                rightest_index = i;
             }
         }
+        leftest_indices[chunk] = leftest_index;
+        rightest_indices[chunk] = rightest_index; });
+
+    size_t leftest_index = leftest_indices[0], rightest_index = rightest_indices[0];
+    for (size_t chunk = 1; chunk < chunk_count; chunk++)
+    {
+        if (points[leftest_indices[chunk]] < points[leftest_index])
+        {
+            leftest_index = leftest_indices[chunk];
+        }
+        if (points[rightest_index] < points[rightest_indices[chunk]])
+        {
+            rightest_index = rightest_indices[chunk];
+        }
+    }
+    Point leftest = points[leftest_index], rightest = points[rightest_index];
+    if (leftest == rightest)
+    {
+        points.resize(1);
+        return points;
     }
 
-    return hull_lines;
-}
\ No newline at end of file
+    // layout after partitioning: [leftest][rightest][below the line][above the line][the rest]
+    swap(points[0], points[leftest_index]);
+    swap(points[1], points[rightest_index == 0 ? leftest_index : rightest_index]);
+    vector<Point> scratch(points.size());
+    vector<uint8_t> labels(points.size());
+    pair<size_t, size_t> sizes = parallel_partition(points, scratch, labels, 2, points.size(), 0, Line(leftest, rightest), Line(rightest, leftest), pool, grain_size);
+    size_t lower_end = 2 + sizes.first, upper_end = lower_end + sizes.second;
+
+    size_t lower_count = 0, upper_count = 0;
+    TaskGroup group(pool);
+    group.run([&]
+              { lower_count = find_hull_parallel(points, scratch, labels, 2, lower_end, leftest, rightest, pool, grain_size); });
+    upper_count = find_hull_parallel(points, scratch, labels, lower_end, upper_end, rightest, leftest, pool, grain_size);
+    group.wait();
+
+    move(points.begin() + 2, points.begin() + 2 + (ptrdiff_t)lower_count, points.begin() + 1);
+    points[1 + lower_count] = rightest;
+    move(points.begin() + (ptrdiff_t)lower_end, points.begin() + (ptrdiff_t)(lower_end + upper_count), points.begin() + (ptrdiff_t)(2 + lower_count));
+
+    points.resize(2 + lower_count + upper_count);
+    remove_reflex_vertices(points);
+    return points;
+}
+
+/**
+ * @brief Build the hull of lexicographically sorted, distinct points with Andrew's monotone chain
+ *
+ * @tparam T the type of the coordinates
+ * @param sorted the sorted points
+ * @param count the number of points
+ * @param hull output, with room for 2 * count points
+ * @return size_t the number of hull points written to hull, in counter-clockwise order starting from sorted[0]
+ */
+template <typename T>
+size_t build_monotone_chain(const BasicPoint<T> *sorted, size_t count, BasicPoint<T> *hull)
+{
+    if (count < 3)
+    {
+        copy(sorted, sorted + count, hull);
+        return count;
+    }
+
+    size_t k = 0;
+
+    // lower hull, from the leftest point to the rightest point
+    for (size_t i = 0; i < count; i++)
+    {
+        while (k >= 2 && orient2d(hull[k - 2], hull[k - 1], sorted[i]) <= 0)
+        {
+            k--;
+        }
+        hull[k++] = sorted[i];
+    }
+
+    // upper hull, from the rightest point back to the leftest point
+    for (size_t i = count - 1, lower_size = k + 1; i > 0; i--)
+    {
+        while (k >= lower_size && orient2d(hull[k - 2], hull[k - 1], sorted[i - 1]) <= 0)
+        {
+            k--;
+        }
+        hull[k++] = sorted[i - 1];
+    }
+
+    // the leftest point is pushed twice
+    return k - 1;
+}
+
+/**
+ * @brief A function to find the convex hull of a set of points using Andrew's monotone chain algorithm
+ * the points are sorted lexicographically, then the lower and upper hulls are built with a stack in O(nlog(n))
+ *
+ * @tparam T the type of the coordinates, the turns are exact for integer coordinates
+ * @tparam Allocator the allocator of the points, which the hull is allocated with
+ * @param points given set of points
+ * @return vector<BasicPoint<T>, Allocator> a vector of points that form the convex hull, in counter-clockwise order starting from the lowest leftmost point
+ */
+template <typename T, typename Allocator = std::allocator<BasicPoint<T>>>
+vector<BasicPoint<T>, Allocator> monotone_chain(vector<BasicPoint<T>, Allocator> points)
+{
+    sort(points.begin(), points.end());
+    points.erase(unique(points.begin(), points.end()), points.end());
+
+    vector<BasicPoint<T>, Allocator> hull(2 * points.size(), points.get_allocator());
+    hull.resize(build_monotone_chain(points.data(), points.size(), hull.data()));
+    return hull;
+}
+
+/**
+ * @brief Estimate the number of points on the convex hull from a sample of the points
+ * the hulls of two nested strided samples are computed, and the growth between them is extrapolated to the whole set
+ *
+ * @param points given set of points
+ * @param sample_size the number of points in the larger sample
+ * @return size_t estimated number of points on the convex hull
+ */
+size_t estimate_hull_size(const vector<Point> &points, size_t sample_size = HULL_SAMPLE_SIZE)
+{
+    size_t n = points.size();
+    if (n <= sample_size)
+    {
+        return monotone_chain(points).size();
+    }
+
+    size_t stride = n / sample_size;
+    vector<Point> large_sample, small_sample;
+    for (size_t i = 0; i < sample_size; i++)
+    {
+        large_sample.push_back(points[i * stride]);
+        if (i % 4 == 0)
+        {
+            small_sample.push_back(points[i * stride]);
+        }
+    }
+
+    double large_hull = (double)monotone_chain(large_sample).size();
+    double small_hull = (double)monotone_chain(small_sample).size();
+
+    // h grows like n^growth: ~1 for points on a circle, ~1/3 in a disk, ~0 in a polygon
+    double growth = log(large_hull / max(small_hull, 1.0)) / log(4.0);
+    growth = min(max(growth, 0.0), 1.0);
+    double estimate = large_hull * pow((double)n / (double)sample_size, growth);
+
+    return (size_t)min(estimate, (double)n);
+}
+
+/**
+ * @brief Find the tangent from an outside point to a convex polygon with a binary search
+ * (following Dan Sunday's tangent_PointPolyC)
+ *
+ * @param p the outside point
+ * @param polygon a convex polygon in counter-clockwise order
+ * @param n the number of vertices of the polygon, at least three
+ * @return size_t the index of the vertex v such that the whole polygon is on the left of p->v
+ */
+size_t tangent_to_polygon(Point p, const Point *polygon, size_t n)
+{
+    auto vertex = [polygon, n](size_t i)
+    { return polygon[i % n]; };
+    // below(i, j): vertex j is on the right of p->vertex i
+    auto below = [&](size_t i, size_t j)
+    { return orient2d(p, vertex(i), vertex(j)) < 0; };
+    auto above = [&](size_t i, size_t j)
+    { return orient2d(p, vertex(i), vertex(j)) > 0; };
+
+    if (below(1, 0) && !above(n - 1, 0))
+    {
+        return 0;
+    }
+
+    size_t a = 0, b = n;
+    while (b - a > 1)
+    {
+        size_t c = (a + b) / 2;
+        bool c_down = below(c + 1, c);
+        if (c_down && !above(c - 1, c))
+        {
+            return c % n;
+        }
+
+        if (above(a + 1, a))
+        {
+            if (c_down || above(a, c))
+            {
+                b = c;
+            }
+            else
+            {
+                a = c;
+            }
+        }
+        else
+        {
+            if (!c_down || !below(a, c))
+            {
+                a = c;
+            }
+            else
+            {
+                b = c;
+            }
+        }
+    }
+    return a % n;
+}
+
+/**
+ * @brief One round of Chan's algorithm: wrap the mini-hulls of groups of m points, giving up after m hull points
+ *
+ * @param points given set of points
+ * @param m the size of the groups, and the largest hull the round can find
+ * @param buffer scratch buffer, reused between rounds
+ * @param mini_hulls scratch buffer holding the vertices of all the mini-hulls one after the other, reused between rounds
+ * @param hull output, the hull if the round succeeds
+ * @return true if the hull has at most m points and was found
+ * @return false otherwise
+ */
+bool chan_round(const vector<Point> &points, size_t m, vector<Point> &buffer, vector<Point> &mini_hulls, vector<Point> &hull)
+{
+    // the mini-hull i is mini_hulls[offsets[i], offsets[i + 1])
+    buffer.assign(points.begin(), points.end());
+    mini_hulls.resize(2 * points.size());
+    vector<size_t> offsets(1, 0);
+    for (size_t begin = 0; begin < points.size(); begin += m)
+    {
+        vector<Point>::iterator first = buffer.begin() + (ptrdiff_t)begin, last = buffer.begin() + (ptrdiff_t)min(points.size(), begin + m);
+        sort(first, last);
+        last = unique(first, last);
+        offsets.push_back(offsets.back() + build_monotone_chain(&*first, (size_t)(last - first), mini_hulls.data() + offsets.back()));
+    }
+    size_t hull_count = offsets.size() - 1;
+    auto hull_size = [&offsets](size_t i)
+    { return offsets[i + 1] - offsets[i]; };
+    auto vertex = [&](size_t i, size_t j)
+    { return mini_hulls[offsets[i] + j]; };
+
+    // the lowest leftmost point is the first vertex of the lexicographically smallest mini-hull
+    size_t current_hull = 0;
+    for (size_t i = 1; i < hull_count; i++)
+    {
+        if (vertex(i, 0) < vertex(current_hull, 0))
+        {
+            current_hull = i;
+        }
+    }
+    size_t current_index = 0;
+    Point start = vertex(current_hull, 0), current = start;
+
+    hull.clear();
+    for (size_t step = 0; step < m; step++)
+    {
+        hull.push_back(current);
+
+        // the successor of the current point on its own mini-hull is always a candidate
+        size_t next_hull = current_hull, next_index = (current_index + 1) % hull_size(current_hull);
+        Point next = vertex(next_hull, next_index);
+
+        // keep the most clockwise candidate, and the farthest one among collinear candidates
+        auto consider = [&](size_t hull_index, size_t vertex_index)
+        {
+            Point candidate = vertex(hull_index, vertex_index);
+            if (candidate == current)
+            {
+                return;
+            }
+            double turn = orient2d(current, next, candidate);
+            if (next == current || turn < 0 || (turn == 0 && current.distance_to(candidate) > current.distance_to(next)))
+            {
+                next = candidate;
+                next_hull = hull_index;
+                next_index = vertex_index;
+            }
+        };
+
+        for (size_t i = 0; i < hull_count; i++)
+        {
+            if (i == current_hull)
+            {
+                continue;
+            }
+            size_t k = hull_size(i);
+            if (k >= 3)
+            {
+                size_t tangent = tangent_to_polygon(current, mini_hulls.data() + offsets[i], k);
+                Point before = vertex(i, (tangent + k - 1) % k), tangent_vertex = vertex(i, tangent), after = vertex(i, (tangent + 1) % k);
+                if (tangent_vertex != current && orient2d(current, tangent_vertex, before) >= 0 && orient2d(current, tangent_vertex, after) >= 0)
+                {
+                    consider(i, tangent);
+                    continue;
+                }
+            }
+            // tiny mini-hulls, and the degenerate cases where the current point lies on the mini-hull, are scanned linearly
+            for (size_t j = 0; j < k; j++)
+            {
+                consider(i, j);
+            }
+        }
+
+        if (next == start)
+        {
+            return true;
+        }
+        current = next;
+        current_hull = next_hull;
+        current_index = next_index;
+    }
+    return false;
+}
+
+/**
+ * @brief A function to find the convex hull of a set of points using Chan's algorithm
+ * the points are split into groups of m, whose hulls are wrapped with binary search tangents in O(nlog(m)) per round,
+ * and m is squared after every failed round, which gives O(nlog(h)) overall; the first m comes from estimate_hull_size,
+ * since rounds with m much smaller than h are wasted
+ *
+ * @param points given set of points
+ * @return vector<Point> a vector of points that form the convex hull, in counter-clockwise order starting from the lowest leftmost point
+ */
+vector<Point> chan(vector<Point> points)
+{
+    if (points.empty())
+    {
+        return points;
+    }
+
+    vector<Point> buffer, mini_hulls, hull;
+    size_t first_m = max((size_t)64, 4 * estimate_hull_size(points));
+    for (size_t m = first_m;; m = m > points.size() / m ? points.size() : m * m)
+    {
+        if (chan_round(points, min(m, points.size()), buffer, mini_hulls, hull))
+        {
+            return hull;
+        }
+    }
+}
+
+/**
+ * @brief A function to find the convex hull of a set of points with the chosen algorithm
+ * with Algorithm::AUTOMATIC the engine is picked from the number of points and the estimated size of the hull:
+ * gift wrapping when the hull is expected to be tiny, Quickhull when it is small compared to the input (in parallel for large inputs
+ * on multi-core hosts), and monotone chain otherwise
+ *
+ * @param points given set of points
+ * @param algorithm the engine to use
+ * @return vector<Point> a vector of points that form the convex hull, in counter-clockwise order starting from the lowest leftmost point
+ */
+vector<Point> convex_hull(vector<Point> points, Algorithm algorithm = Algorithm::AUTOMATIC)
+{
+    // every engine other than monotone chain expects at least three points
+    if (points.size() < 3)
+    {
+        return monotone_chain(points);
+    }
+
+    if (algorithm == Algorithm::AUTOMATIC)
+    {
+        size_t n = points.size();
+        if (n <= HULL_SAMPLE_SIZE)
+        {
+            algorithm = Algorithm::MONOTONE_CHAIN;
+        }
+        else
+        {
+            double estimated_hull = (double)estimate_hull_size(points);
+            if (estimated_hull <= log2((double)n))
+            {
+                algorithm = Algorithm::GIFT_WRAPPING;
+            }
+            else if (estimated_hull <= sqrt((double)n))
+            {
+                algorithm = n >= 4 * QUICKHULL_GRAIN_SIZE && default_thread_pool().size() > 1 ? Algorithm::PARALLEL_QUICK_HULL : Algorithm::QUICK_HULL;
+            }
+            else
+            {
+                algorithm = Algorithm::MONOTONE_CHAIN;
+            }
+        }
+    }
+
+    switch (algorithm)
+    {
+    case Algorithm::GIFT_WRAPPING:
+        return gift_wrapping(points);
+    case Algorithm::QUICK_HULL:
+        return quick_hull_in_place(points);
+    case Algorithm::PARALLEL_QUICK_HULL:
+        return quick_hull_parallel(points);
+    case Algorithm::CHAN:
+        return chan(points);
+    default:
+        return monotone_chain(points);
+    }
+}
+
+/**
+ * @brief A function to find the convex hull of a set of points with integer coordinates
+ * every turn is an exact integer cross product, so the hull is exact whatever the input; the parallel Quickhull and
+ * Chan's algorithm only exist for double coordinates, so they are replaced with the in-place Quickhull
+ *
+ * @tparam T the type of the coordinates, an integer type of at most 32 bits
+ * @param points given set of points
+ * @param algorithm the engine to use
+ * @return vector<BasicPoint<T>> a vector of points that form the convex hull, in counter-clockwise order starting from the lowest leftmost point
+ */
+template <std::integral T>
+vector<BasicPoint<T>> convex_hull(vector<BasicPoint<T>> points, Algorithm algorithm = Algorithm::AUTOMATIC)
+{
+    if (points.size() < 3 || algorithm == Algorithm::MONOTONE_CHAIN || (algorithm == Algorithm::AUTOMATIC && points.size() <= HULL_SAMPLE_SIZE))
+    {
+        return monotone_chain(points);
+    }
+    if (algorithm == Algorithm::GIFT_WRAPPING)
+    {
+        return gift_wrapping(points);
+    }
+    return quick_hull_in_place(points);
+}
+
+/**
+ * @brief Add the points lying on the edges of a hull to it, as vertices in counter-clockwise order
+ * the hull is split at its rightest point into a lower and an upper chain, both sorted lexicographically, so the edge
+ * under a point is found with a binary search, in O(nlog(h)) overall
+ *
+ * @param hull a hull without collinear vertices, in counter-clockwise order starting from the lowest leftmost point
+ * @param points the points the hull was computed from
+ * @return vector<Point> the hull with every distinct point of its boundary
+ */
+vector<Point> add_collinear_points(vector<Point> hull, const vector<Point> &points)
+{
+    size_t n = hull.size();
+    if (n < 2)
+    {
+        return hull;
+    }
+    size_t rightest = (size_t)(max_element(hull.begin(), hull.end()) - hull.begin());
+    auto vertex = [&hull, n](size_t i)
+    { return hull[i % n]; };
+
+    // every point on an edge, with the index of the edge starting vertex
+    vector<pair<size_t, Point>> on_edges;
+    for (Point p : points)
+    {
+        if (p < hull[0] || hull[rightest] < p)
+        {
+            continue;
+        }
+
+        // the lower chain is hull[0, rightest] in increasing order
+        size_t edge = (size_t)(upper_bound(hull.begin(), hull.begin() + (ptrdiff_t)rightest + 1, p) - hull.begin()) - 1;
+        if (edge < rightest && hull[edge] != p && orient2d(hull[edge], hull[edge + 1], p) == 0)
+        {
+            on_edges.push_back(make_pair(edge, p));
+            continue;
+        }
+        // a segment has no upper chain, its only edge is already the lower one
+        if (n == 2)
+        {
+            continue;
+        }
+
+        // the upper chain is hull[rightest, n] in decreasing order, where hull[n] is hull[0]
+        size_t low = rightest, high = n;
+        while (high - low > 1)
+        {
+            size_t middle = (low + high) / 2;
+            if (p < vertex(middle))
+            {
+                low = middle;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        if (vertex(low) != p && vertex(high) != p && orient2d(vertex(low), vertex(high), p) == 0)
+        {
+            on_edges.push_back(make_pair(low, p));
+        }
+    }
+
+    // the points of an edge are ordered by their distance to its starting vertex
+    sort(on_edges.begin(), on_edges.end(), [&hull](const pair<size_t, Point> &a, const pair<size_t, Point> &b)
+         { return a.first != b.first ? a.first < b.first : hull[a.first].distance_to(a.second) < hull[b.first].distance_to(b.second); });
+    on_edges.erase(unique(on_edges.begin(), on_edges.end(), [](const pair<size_t, Point> &a, const pair<size_t, Point> &b)
+                          { return a.second == b.second; }),
+                   on_edges.end());
+
+    vector<Point> merged;
+    merged.reserve(n + on_edges.size());
+    size_t next = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        merged.push_back(hull[i]);
+        for (; next < on_edges.size() && on_edges[next].first == i; next++)
+        {
+            merged.push_back(on_edges[next].second);
+        }
+    }
+    return merged;
+}
+
+/**
+ * @brief A function to find the convex hull of a set of points with the given options
+ * with options.prefilter, the points that cannot be on the hull are discarded by akl_toussaint_filter before the engine
+ * (and the automatic choice of the engine) runs; the prefilter never discards a point on the boundary, so it can be combined
+ * with options.keep_collinear
+ *
+ * @param points given set of points
+ * @param options
+ * @return vector<Point> a vector of points that form the convex hull
+ */
+vector<Point> convex_hull(vector<Point> points, HullOptions options)
+{
+    if (options.prefilter)
+    {
+        akl_toussaint_filter(points);
+    }
+    if (options.survivors != nullptr)
+    {
+        *options.survivors = points.size();
+    }
+    if (options.keep_collinear)
+    {
+        return add_collinear_points(convex_hull(points, options.algorithm), points);
+    }
+    return convex_hull(points, options.algorithm);
+}
+
+/**
+ * @brief A function to find the convex hull of a read-only array of points without copying it
+ * the points strictly inside the Akl-Toussaint octagon are skipped while streaming over the array, and the engine runs
+ * on a copy of the survivors only, so options.prefilter is always on
+ *
+ * @param points given set of points, for example a mapped file
+ * @param options
+ * @return vector<Point> a vector of points that form the convex hull
+ */
+vector<Point> convex_hull(std::span<const Point> points, HullOptions options = HullOptions())
+{
+    options.prefilter = false;
+    return convex_hull(gather_akl_toussaint_survivors(points.size(), [points](size_t i)
+                                                      { return points[i]; }),
+                       options);
+}
+
+/**
+ * @brief A function to find the convex hull of read-only arrays of x and y coordinates without copying them
+ *
+ * @param xs the x coordinates
+ * @param ys the y coordinates, as many as xs
+ * @param options
+ * @return vector<Point> a vector of points that form the convex hull
+ */
+vector<Point> convex_hull(std::span<const double> xs, std::span<const double> ys, HullOptions options = HullOptions())
+{
+    options.prefilter = false;
+    return convex_hull(gather_akl_toussaint_survivors(xs.size(), [xs, ys](size_t i)
+                                                      { return Point(xs[i], ys[i]); }),
+                       options);
+}
+
+/**
+ * @brief A view over the edges of a hull, from every vertex to the next one and from the last vertex back to the first
+ * the edges are built on the fly from the vertices, so iterating over them takes O(h) and allocates nothing
+ */
+class HullEdges
+{
+private:
+    const Point *vertices;
+    size_t count;
+
+public:
+    /**
+     * @brief A forward iterator over the edges
+     */
+    class Iterator
+    {
+    private:
+        const Point *vertices;
+        size_t count, index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Line;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Line *;
+        using reference = Line;
+
+        Iterator() : vertices(nullptr), count(0), index(0)
+        {
+        }
+
+        Iterator(const Point *vertices_to_set, size_t count_to_set, size_t index_to_set)
+            : vertices(vertices_to_set), count(count_to_set), index(index_to_set)
+        {
+        }
+
+        Line operator*() const
+        {
+            return Line(vertices[index], vertices[index + 1 == count ? 0 : index + 1]);
+        }
+
+        Iterator &operator++()
+        {
+            index++;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            index++;
+            return previous;
+        }
+
+        bool operator==(const Iterator &other) const
+        {
+            return index == other.index;
+        }
+
+        bool operator!=(const Iterator &other) const
+        {
+            return index != other.index;
+        }
+    };
+
+    /**
+     * @brief Construct a new Hull Edges object, valid as long as the vertices are
+     *
+     * @param vertices_to_set the vertices of the hull in order
+     * @param count_to_set the number of vertices
+     */
+    HullEdges(const Point *vertices_to_set, size_t count_to_set) : vertices(vertices_to_set), count(count_to_set)
+    {
+    }
+
+    Iterator begin() const
+    {
+        return Iterator(vertices, count, 0);
+    }
+
+    Iterator end() const
+    {
+        return Iterator(vertices, count, size());
+    }
+
+    /**
+     * @brief Get the number of edges: none for a single point, one for a segment, and one per vertex for a polygon
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return count < 2 ? 0 : (count == 2 ? 1 : count);
+    }
+};
+
+/**
+ * @brief Get a view over the edges of a hull
+ *
+ * @param convex_hull the vertices of the hull in order, as returned by any engine
+ * @return HullEdges
+ */
+HullEdges hull_edges(const vector<Point> &convex_hull)
+{
+    return HullEdges(convex_hull.data(), convex_hull.size());
+}
+
+/**
+ * @brief Gets the set of lines that form the convex hull / connect the points of the convex hull
+ *
+ * @param convex_hull the vertices of the hull in order, as returned by any engine
+ * @return vector<Line> the edges of the hull, in the order of its vertices
+ */
+vector<Line> get_convex_hull_lines(const vector<Point> &convex_hull)
+{
+    HullEdges edges = hull_edges(convex_hull);
+    vector<Line> hull_lines;
+    hull_lines.reserve(edges.size());
+    for (Line line : edges)
+    {
+        hull_lines.push_back(line);
+    }
+    return hull_lines;
+}
+
+/**
+ * @brief Gets the set of lines that form the convex hull, allocated from a memory resource
+ *
+ * @param convex_hull the vertices of the hull in order, as returned by any engine
+ * @param resource the memory resource to allocate from
+ * @return std::pmr::vector<Line> the edges of the hull, in the order of its vertices
+ */
+std::pmr::vector<Line> get_convex_hull_lines(std::span<const Point> convex_hull, std::pmr::memory_resource *resource)
+{
+    HullEdges edges = HullEdges(convex_hull.data(), convex_hull.size());
+    std::pmr::vector<Line> hull_lines(resource);
+    hull_lines.reserve(edges.size());
+    for (Line line : edges)
+    {
+        hull_lines.push_back(line);
+    }
+    return hull_lines;
+}
@@ -0,0 +1,528 @@
+/**
+ * @file convex_polygon.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief Operations on two convex polygons, such as hulls, in linear time: their intersection and their Minkowski sum
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+#include "geometry.hpp"
+#include "convex_hull.hpp"
+#include "batch_hull.hpp"
+#include "thread_pool.hpp"
+
+#define POLYGON_GRAIN_SIZE 1024
+
+/**
+ * @brief Bring a convex polygon built from computed points back to the form the engines return
+ * the polygon is rotated to start from its lowest leftmost vertex, and the repeated, collinear and reflex vertices that
+ * rounding leaves are removed in O(h); a polygon with no area is reduced to its two extreme points, or a single point
+ *
+ * @param polygon a polygon in counter-clockwise order, from any vertex
+ */
+void normalize_convex_polygon(vector<Point> &polygon)
+{
+    if (polygon.empty())
+    {
+        return;
+    }
+    rotate(polygon.begin(), min_element(polygon.begin(), polygon.end()), polygon.end());
+    Point last = *max_element(polygon.begin(), polygon.end());
+    bool flat = true;
+    for (size_t i = 1; i < polygon.size() && flat; i++)
+    {
+        flat = orient2d(polygon[0], last, polygon[i]) == 0;
+    }
+    if (flat)
+    {
+        polygon.resize(1);
+        if (last != polygon[0])
+        {
+            polygon.push_back(last);
+        }
+        return;
+    }
+    remove_reflex_vertices(polygon);
+}
+
+/**
+ * @brief Check if a point is inside a convex polygon or on its boundary, in O(h)
+ *
+ * @param polygon a convex polygon in counter-clockwise order, as returned by any engine, possibly a point or a segment
+ * @param p
+ * @return true if the point is not outside the polygon
+ * @return false otherwise
+ */
+bool convex_polygon_contains(std::span<const Point> polygon, Point p)
+{
+    if (polygon.size() < 3)
+    {
+        return polygon.size() == 1 ? p == polygon[0] : polygon.size() == 2 && orient2d(polygon[0], polygon[1], p) == 0 && !(p < min(polygon[0], polygon[1])) && !(max(polygon[0], polygon[1]) < p);
+    }
+    for (size_t i = 0; i < polygon.size(); i++)
+    {
+        if (orient2d(polygon[i], polygon[(i + 1) % polygon.size()], p) < 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Get the signed area of a polygon, positive if it is counter-clockwise
+ *
+ * @param polygon
+ * @return double
+ */
+double polygon_area(std::span<const Point> polygon)
+{
+    double area = 0;
+    for (size_t i = 0; i < polygon.size(); i++)
+    {
+        Point a = polygon[i], b = polygon[(i + 1) % polygon.size()];
+        area += a.get_x() * b.get_y() - a.get_y() * b.get_x();
+    }
+    return area / 2;
+}
+
+/**
+ * @brief Intersect a segment with a convex polygon of at least three vertices, or with another segment or a point
+ *
+ * @param a start of the segment
+ * @param b end of the segment, possibly equal to the start
+ * @param polygon a convex polygon in counter-clockwise order, as returned by any engine
+ * @param intersection output, the part of the segment inside the polygon
+ */
+void intersect_segment(Point a, Point b, std::span<const Point> polygon, vector<Point> &intersection)
+{
+    intersection.clear();
+    Point segment[2] = {a, b};
+    if (a == b || polygon.size() == 1)
+    {
+        Point p = a == b ? a : polygon[0];
+        if (convex_polygon_contains(a == b ? polygon : std::span<const Point>(segment), p))
+        {
+            intersection.push_back(p);
+        }
+        return;
+    }
+
+    if (polygon.size() == 2)
+    {
+        Point c = polygon[0], d = polygon[1];
+        double c_side = orient2d(a, b, c), d_side = orient2d(a, b, d), a_side = orient2d(c, d, a), b_side = orient2d(c, d, b);
+        if (c_side == 0 && d_side == 0)
+        {
+            // collinear, the overlap of the two segments in lexicographic order
+            Point low = max(min(a, b), min(c, d)), high = min(max(a, b), max(c, d));
+            if (!(high < low))
+            {
+                intersection.push_back(low);
+            }
+            if (low < high)
+            {
+                intersection.push_back(high);
+            }
+            return;
+        }
+        if ((c_side > 0 && d_side > 0) || (c_side < 0 && d_side < 0) || (a_side > 0 && b_side > 0) || (a_side < 0 && b_side < 0))
+        {
+            return;
+        }
+        double t = a_side / (a_side - b_side);
+        intersection.push_back(a_side == 0 ? a : b_side == 0 ? b : c_side == 0 ? c : d_side == 0 ? d : Point(a.get_x() + t * (b.get_x() - a.get_x()), a.get_y() + t * (b.get_y() - a.get_y())));
+        return;
+    }
+
+    // clip the segment by the half-plane on the left of every edge, as the parameters of its ends
+    double low = 0, high = 1;
+    for (size_t i = 0; i < polygon.size() && low <= high; i++)
+    {
+        Point c = polygon[i], d = polygon[(i + 1) % polygon.size()];
+        double a_side = orient2d(c, d, a), b_side = orient2d(c, d, b);
+        if (a_side < 0 && b_side < 0)
+        {
+            return;
+        }
+        if (a_side < 0)
+        {
+            low = max(low, a_side / (a_side - b_side));
+        }
+        else if (b_side < 0)
+        {
+            high = min(high, a_side / (a_side - b_side));
+        }
+    }
+    if (low > high)
+    {
+        return;
+    }
+    auto at = [&](double t)
+    {
+        return t == 0 ? a : t == 1 ? b : Point(a.get_x() + t * (b.get_x() - a.get_x()), a.get_y() + t * (b.get_y() - a.get_y()));
+    };
+    intersection.push_back(at(low));
+    intersection.push_back(at(high));
+    normalize_convex_polygon(intersection);
+}
+
+/**
+ * @brief A function to find the intersection of two convex polygons in O(n + m), by advancing along their edges
+ * following O'Rourke, Chin, Olson and Naddor: one edge of each polygon is followed, and the one aiming at the other is
+ * advanced, so that both boundaries are walked at most twice; every crossing switches which boundary is inside, and the
+ * vertices of the inner boundary are output between crossings. All the turns are exact, only the crossings are rounded.
+ * When the boundaries do not cross, the polygons are nested, touching, or disjoint
+ *
+ * @param a a convex polygon in counter-clockwise order, as returned by any engine
+ * @param b a convex polygon in the same order
+ * @param intersection output, the intersection in counter-clockwise order starting from its lowest leftmost point; a point
+ * or a segment if the polygons only touch, and empty if they are disjoint. Its memory is reused
+ */
+void convex_intersection(std::span<const Point> a, std::span<const Point> b, vector<Point> &intersection)
+{
+    intersection.clear();
+    if (a.empty() || b.empty())
+    {
+        return;
+    }
+    if (a.size() < 3 || b.size() < 3)
+    {
+        std::span<const Point> segment = a.size() < b.size() ? a : b, polygon = a.size() < b.size() ? b : a;
+        intersect_segment(segment.front(), segment.back(), polygon, intersection);
+        return;
+    }
+
+    enum class Inside
+    {
+        UNKNOWN,
+        A,
+        B
+    };
+    size_t n = a.size(), m = b.size(), i = 0, j = 0, i_advances = 0, j_advances = 0;
+    Inside inside = Inside::UNKNOWN;
+    auto advance = [&intersection](size_t &index, size_t &advances, size_t size, bool output, Point vertex)
+    {
+        if (output)
+        {
+            intersection.push_back(vertex);
+        }
+        advances++;
+        index = (index + 1) % size;
+    };
+
+    do
+    {
+        // the edges a[i - 1] -> a[i] and b[j - 1] -> b[j]
+        Point a_start = a[(i + n - 1) % n], a_end = a[i], b_start = b[(j + m - 1) % m], b_end = b[j];
+        Point a_direction = a_end - a_start, b_direction = b_end - b_start;
+        double cross = orient2d(Point(0, 0), a_direction, b_direction);
+        double a_start_side = orient2d(b_start, b_end, a_start), a_end_side = orient2d(b_start, b_end, a_end);
+        double b_start_side = orient2d(a_start, a_end, b_start), b_end_side = orient2d(a_start, a_end, b_end);
+
+        if (a_start_side == 0 && a_end_side == 0)
+        {
+            // collinear edges pointing in opposite directions: the polygons touch along their overlap
+            if (a_direction.get_x() * b_direction.get_x() + a_direction.get_y() * b_direction.get_y() < 0)
+            {
+                Point low = max(min(a_start, a_end), min(b_start, b_end)), high = min(max(a_start, a_end), max(b_start, b_end));
+                if (!(high < low))
+                {
+                    intersection.assign({low, high});
+                    normalize_convex_polygon(intersection);
+                    return;
+                }
+            }
+        }
+        else if (!((a_start_side > 0 && a_end_side > 0) || (a_start_side < 0 && a_end_side < 0) || (b_start_side > 0 && b_end_side > 0) || (b_start_side < 0 && b_end_side < 0)))
+        {
+            // the edges meet: properly, or at an end of one of them
+            double t = a_start_side / (a_start_side - a_end_side);
+            Point crossing = a_start_side == 0 ? a_start : a_end_side == 0 ? a_end : b_start_side == 0 ? b_start : b_end_side == 0 ? b_end : Point(a_start.get_x() + t * a_direction.get_x(), a_start.get_y() + t * a_direction.get_y());
+            if (inside == Inside::UNKNOWN && intersection.empty())
+            {
+                i_advances = j_advances = 0;
+            }
+            intersection.push_back(crossing);
+            inside = a_end_side > 0 ? Inside::A : b_end_side > 0 ? Inside::B : inside;
+        }
+
+        if (cross == 0 && a_end_side < 0 && b_end_side < 0)
+        {
+            // parallel edges facing away from each other, so a line separates the polygons
+            intersection.clear();
+            return;
+        }
+        if (cross == 0 && a_end_side == 0 && b_end_side == 0)
+        {
+            if (inside == Inside::A)
+            {
+                advance(j, j_advances, m, false, b_end);
+            }
+            else
+            {
+                advance(i, i_advances, n, false, a_end);
+            }
+        }
+        else if (cross >= 0)
+        {
+            if (b_end_side > 0)
+            {
+                advance(i, i_advances, n, inside == Inside::A, a_end);
+            }
+            else
+            {
+                advance(j, j_advances, m, inside == Inside::B, b_end);
+            }
+        }
+        else
+        {
+            if (a_end_side > 0)
+            {
+                advance(j, j_advances, m, inside == Inside::B, b_end);
+            }
+            else
+            {
+                advance(i, i_advances, n, inside == Inside::A, a_end);
+            }
+        }
+    } while ((i_advances < n || j_advances < m) && i_advances < 2 * n && j_advances < 2 * m);
+
+    if (inside == Inside::UNKNOWN)
+    {
+        // the boundaries do not cross: if the interiors meet, the smaller polygon is inside the other one, otherwise the
+        // polygons are disjoint or only touch where the edges met. A point strictly inside a polygon is the centroid of
+        // three of its vertices
+        auto centroid = [](std::span<const Point> polygon)
+        {
+            return Point((polygon[0].get_x() + polygon[1].get_x() + polygon[2].get_x()) / 3, (polygon[0].get_y() + polygon[1].get_y() + polygon[2].get_y()) / 3);
+        };
+        auto strictly_inside = [](std::span<const Point> polygon, Point p)
+        {
+            for (size_t k = 0; k < polygon.size(); k++)
+            {
+                if (orient2d(polygon[k], polygon[(k + 1) % polygon.size()], p) <= 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+        if (strictly_inside(b, centroid(a)) || strictly_inside(a, centroid(b)))
+        {
+            std::span<const Point> smaller = polygon_area(a) <= polygon_area(b) ? a : b;
+            intersection.assign(smaller.begin(), smaller.end());
+            return;
+        }
+    }
+    normalize_convex_polygon(intersection);
+}
+
+/**
+ * @brief A function to find the intersection of two convex polygons in O(n + m)
+ *
+ * @param a a convex polygon in counter-clockwise order, as returned by any engine
+ * @param b a convex polygon in the same order
+ * @return vector<Point> the intersection in counter-clockwise order starting from its lowest leftmost point
+ */
+vector<Point> convex_intersection(std::span<const Point> a, std::span<const Point> b)
+{
+    vector<Point> intersection;
+    convex_intersection(a, b, intersection);
+    return intersection;
+}
+
+/**
+ * @brief The half of the plane an edge direction points to, as seen from the lowest leftmost vertex of a polygon: 0 for
+ * the directions from straight down, excluded, to straight up, and 1 for the others
+ *
+ * @param direction
+ * @return int
+ */
+inline int direction_half(Point direction)
+{
+    return direction.get_x() > 0 || (direction.get_x() == 0 && direction.get_y() > 0) ? 0 : 1;
+}
+
+/**
+ * @brief A function to find the Minkowski sum of two convex polygons in O(n + m)
+ * from the sum of their lowest leftmost vertices, which is the lowest leftmost vertex of the sum, the edges of both
+ * polygons are merged by their direction, so the sum is walked once around, like merging two sorted lists
+ *
+ * @param a a convex polygon in counter-clockwise order, as returned by any engine
+ * @param b a convex polygon in the same order
+ * @param sum output, the polygon of every sum of a point of a and a point of b, in counter-clockwise order starting from
+ * its lowest leftmost point, empty if either polygon is. Its memory is reused
+ */
+void minkowski_sum(std::span<const Point> a, std::span<const Point> b, vector<Point> &sum)
+{
+    sum.clear();
+    if (a.empty() || b.empty())
+    {
+        return;
+    }
+    size_t n = a.size(), m = b.size();
+    // a single point has no edge, a segment has two, from one end to the other and back
+    size_t a_edges = n == 1 ? 0 : n, b_edges = m == 1 ? 0 : m;
+    auto a_edge = [&](size_t i)
+    {
+        return a[(i + 1) % n] - a[i];
+    };
+    auto b_edge = [&](size_t j)
+    {
+        return b[(j + 1) % m] - b[j];
+    };
+
+    size_t i = 0, j = 0;
+    while (i < a_edges || j < b_edges)
+    {
+        sum.push_back(Point(a[i % n].get_x() + b[j % m].get_x(), a[i % n].get_y() + b[j % m].get_y()));
+        if (j == b_edges)
+        {
+            i++;
+        }
+        else if (i == a_edges)
+        {
+            j++;
+        }
+        else
+        {
+            Point a_direction = a_edge(i), b_direction = b_edge(j);
+            int a_half = direction_half(a_direction), b_half = direction_half(b_direction);
+            double cross = a_half == b_half ? orient2d(Point(0, 0), a_direction, b_direction) : 0;
+            bool a_first = a_half < b_half || (a_half == b_half && cross >= 0);
+            bool b_first = b_half < a_half || (a_half == b_half && cross <= 0);
+            i += a_first;
+            j += b_first;
+        }
+    }
+    if (sum.empty())
+    {
+        sum.push_back(Point(a[0].get_x() + b[0].get_x(), a[0].get_y() + b[0].get_y()));
+    }
+    normalize_convex_polygon(sum);
+}
+
+/**
+ * @brief A function to find the Minkowski sum of two convex polygons in O(n + m)
+ *
+ * @param a a convex polygon in counter-clockwise order, as returned by any engine
+ * @param b a convex polygon in the same order
+ * @return vector<Point> the sum in counter-clockwise order starting from its lowest leftmost point
+ */
+vector<Point> minkowski_sum(std::span<const Point> a, std::span<const Point> b)
+{
+    vector<Point> sum;
+    minkowski_sum(a, b, sum);
+    return sum;
+}
+
+/**
+ * @brief Apply an operation to every pair of polygons from two batches, in parallel
+ * every chunk reuses one buffer for the results of its pairs and writes them one after the other into the part of the
+ * output that their bound spans, and the chunks are then moved together, like batch_convex_hull
+ *
+ * @tparam Operation a function of (polygon, polygon, result) writing a polygon of at most n + m vertices to the result
+ * @param first
+ * @param second
+ * @param results output, the result for every pair; its memory is reused
+ * @param operation
+ * @param pool the pool running the operations
+ * @param grain_size the minimum number of pairs in a chunk
+ * @return true if the results were found
+ * @return false if the batches do not have the same number of polygons
+ */
+template <typename Operation>
+bool pairwise_polygons(const HullBatch &first, const HullBatch &second, HullBatch &results, Operation operation, ThreadPool &pool, size_t grain_size)
+{
+    results.points.clear();
+    results.offsets.clear();
+    if (first.size() != second.size())
+    {
+        return false;
+    }
+
+    size_t pair_count = first.size();
+    // an empty batch may have no offsets at all
+    if (pair_count == 0)
+    {
+        results.offsets.assign(1, 0);
+        return true;
+    }
+    results.offsets.resize(pair_count + 1);
+    results.points.resize(first.points.size() + second.points.size());
+    size_t chunk_count = parallel_chunk_count(pool, pair_count, grain_size);
+    vector<size_t> chunk_begins(chunk_count), chunk_ends(chunk_count), chunk_sizes(chunk_count);
+    parallel_chunks(pool, 0, pair_count, chunk_count, [&](size_t chunk, size_t chunk_begin, size_t chunk_end)
+                    {
+        // the pairs before the chunk bound the size of their results, so the region starting there is free
+        Point *output = results.points.data() + first.offsets[chunk_begin] - first.offsets[0] + second.offsets[chunk_begin] - second.offsets[0];
+        vector<Point> result;
+        size_t written = 0;
+        for (size_t i = chunk_begin; i < chunk_end; i++)
+        {
+            operation(first[i], second[i], result);
+            results.offsets[i] = written;
+            copy(result.begin(), result.end(), output + written);
+            written += result.size();
+        }
+        chunk_begins[chunk] = chunk_begin;
+        chunk_ends[chunk] = chunk_end;
+        chunk_sizes[chunk] = written; });
+
+    size_t total = 0;
+    for (size_t chunk = 0; chunk < chunk_count; chunk++)
+    {
+        size_t source = first.offsets[chunk_begins[chunk]] - first.offsets[0] + second.offsets[chunk_begins[chunk]] - second.offsets[0];
+        move(results.points.begin() + (ptrdiff_t)source, results.points.begin() + (ptrdiff_t)(source + chunk_sizes[chunk]), results.points.begin() + (ptrdiff_t)total);
+        for (size_t i = chunk_begins[chunk]; i < chunk_ends[chunk]; i++)
+        {
+            results.offsets[i] += total;
+        }
+        total += chunk_sizes[chunk];
+    }
+    results.offsets[pair_count] = total;
+    results.points.resize(total);
+    return true;
+}
+
+/**
+ * @brief A function to intersect every pair of polygons from two batches, the i-th of one with the i-th of the other, in parallel
+ *
+ * @param first
+ * @param second
+ * @param intersections output, the intersection of every pair; its memory is reused
+ * @param pool the pool intersecting the pairs
+ * @param grain_size the minimum number of pairs in a chunk
+ * @return true if the intersections were found
+ * @return false if the batches do not have the same number of polygons
+ */
+bool convex_intersections(const HullBatch &first, const HullBatch &second, HullBatch &intersections, ThreadPool &pool = default_thread_pool(), size_t grain_size = POLYGON_GRAIN_SIZE)
+{
+    return pairwise_polygons(first, second, intersections, [](std::span<const Point> a, std::span<const Point> b, vector<Point> &result)
+                             { convex_intersection(a, b, result); }, pool, grain_size);
+}
+
+/**
+ * @brief A function to find the Minkowski sum of every pair of polygons from two batches, in parallel
+ *
+ * @param first
+ * @param second
+ * @param sums output, the sum of every pair; its memory is reused
+ * @param pool the pool summing the pairs
+ * @param grain_size the minimum number of pairs in a chunk
+ * @return true if the sums were found
+ * @return false if the batches do not have the same number of polygons
+ */
+bool minkowski_sums(const HullBatch &first, const HullBatch &second, HullBatch &sums, ThreadPool &pool = default_thread_pool(), size_t grain_size = POLYGON_GRAIN_SIZE)
+{
+    return pairwise_polygons(first, second, sums, [](std::span<const Point> a, std::span<const Point> b, vector<Point> &result)
+                             { minkowski_sum(a, b, result); }, pool, grain_size);
+}
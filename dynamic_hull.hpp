@@ -0,0 +1,560 @@
+/**
+ * @file dynamic_hull.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief A fully dynamic convex hull supporting insertions and deletions, in the style of Overmars and van Leeuwen
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "geometry.hpp"
+
+/**
+ * @brief A convex hull of a set of points that can both grow and shrink
+ * the points are the leaves of a balanced (AVL) binary tree, sorted lexicographically, and every internal node stores the
+ * bridges joining the upper and lower hulls of its two children. A bridge is found by walking down both children at once
+ * in O(log(n)), and an update fixes the O(log(n)) nodes above the changed leaf, so insert and erase cost O(log(n)^2)
+ */
+class DynamicHull
+{
+private:
+    static constexpr size_t NO_NODE = SIZE_MAX;
+
+    /**
+     * @brief The edge joining the hulls of the two children of a node
+     * first is a vertex of the child visited first along the chain, second a vertex of the other child
+     */
+    struct Bridge
+    {
+        Point first, second;
+    };
+
+    /**
+     * @brief A node of the tree, a leaf holds one point and has no children
+     */
+    struct Node
+    {
+        size_t left, right;
+        int height;
+        Point min, max;
+        Bridge upper, lower;
+    };
+
+    /**
+     * @brief The nodes are kept in one array and freed nodes are reused, so the tree needs no allocation per update
+     */
+    std::vector<Node> nodes;
+    std::vector<size_t> free_nodes;
+    size_t root;
+    size_t count;
+
+    // the lower hull is handled as the upper hull of the points rotated by 180 degrees, so both chains share one walk.
+    // the rotation reverses the order of the points, so the chain of a node visits its right child first
+
+    /**
+     * @brief Rotate a point by 180 degrees for the lower chain, keep it for the upper one
+     *
+     * @tparam LOWER the chain
+     * @param p
+     * @return Point
+     */
+    template <bool LOWER>
+    static Point chain_point(Point p)
+    {
+        return LOWER ? Point(-p.get_x(), -p.get_y()) : p;
+    }
+
+    template <bool LOWER>
+    size_t first_child(size_t node) const
+    {
+        return LOWER ? nodes[node].right : nodes[node].left;
+    }
+
+    template <bool LOWER>
+    size_t second_child(size_t node) const
+    {
+        return LOWER ? nodes[node].left : nodes[node].right;
+    }
+
+    template <bool LOWER>
+    const Bridge &bridge(size_t node) const
+    {
+        return LOWER ? nodes[node].lower : nodes[node].upper;
+    }
+
+    bool is_leaf(size_t node) const
+    {
+        return nodes[node].left == NO_NODE;
+    }
+
+    int height(size_t node) const
+    {
+        return node == NO_NODE ? 0 : nodes[node].height;
+    }
+
+    /**
+     * @brief Get the edge of the chain of a subtree stored at its root, in chain coordinates, a leaf is its own edge
+     *
+     * @tparam LOWER the chain
+     * @param node
+     * @param a where the first endpoint is stored
+     * @param b where the second endpoint is stored
+     */
+    template <bool LOWER>
+    void chain_edge(size_t node, Point &a, Point &b) const
+    {
+        if (is_leaf(node))
+        {
+            a = chain_point<LOWER>(nodes[node].min);
+            b = a;
+            return;
+        }
+        a = chain_point<LOWER>(bridge<LOWER>(node).first);
+        b = chain_point<LOWER>(bridge<LOWER>(node).second);
+    }
+
+    /**
+     * @brief Check if the line through a and b is above the line through c and d at a given x
+     * both lines must go from left to right
+     *
+     * @param a
+     * @param b
+     * @param c
+     * @param d
+     * @param x
+     * @return true if it is strictly above
+     * @return false otherwise
+     */
+    static bool above_at(Point a, Point b, Point c, Point d, double x)
+    {
+        double dx_ab = b.get_x() - a.get_x(), dx_cd = d.get_x() - c.get_x();
+        double ab = a.get_y() * dx_ab + (x - a.get_x()) * (b.get_y() - a.get_y());
+        double cd = c.get_y() * dx_cd + (x - c.get_x()) * (d.get_y() - c.get_y());
+        return ab * dx_cd > cd * dx_ab;
+    }
+
+    /**
+     * @brief Find the bridge joining the chains of the two children of a node
+     * the walk keeps one node in each child, and every step discards the half of one of their chains that cannot hold the
+     * bridge, using the edges stored at the two nodes. When the bridge is on a line with other vertices, the outermost
+     * ones are kept so that the chain has no collinear vertices
+     *
+     * @tparam LOWER the chain
+     * @param node an internal node
+     * @return Bridge
+     */
+    template <bool LOWER>
+    Bridge find_bridge(size_t node) const
+    {
+        size_t x = first_child<LOWER>(node), y = second_child<LOWER>(node);
+        // every point of the second child is on the right of this line
+        double separator = LOWER ? chain_point<LOWER>(nodes[y].max).get_x() : nodes[y].min.get_x();
+        Point a, b, c, d;
+
+        while (true)
+        {
+            chain_edge<LOWER>(x, a, b);
+            chain_edge<LOWER>(y, c, d);
+            bool x_leaf = is_leaf(x), y_leaf = is_leaf(y);
+            if (x_leaf && y_leaf)
+            {
+                return Bridge{chain_point<LOWER>(a), chain_point<LOWER>(c)};
+            }
+
+            // a point of one side on or above the edge of the other side puts the bridge before that edge on the first
+            // side, or after it on the second side
+            bool first_goes_left = !x_leaf && (orient2d(a, b, c) >= 0 || orient2d(a, b, d) >= 0);
+            bool second_goes_right = !y_leaf && (orient2d(c, d, a) >= 0 || orient2d(c, d, b) >= 0);
+            if (x_leaf)
+            {
+                y = second_goes_right ? second_child<LOWER>(y) : first_child<LOWER>(y);
+            }
+            else if (y_leaf)
+            {
+                x = first_goes_left ? first_child<LOWER>(x) : second_child<LOWER>(x);
+            }
+            else if (first_goes_left || second_goes_right)
+            {
+                x = first_goes_left ? first_child<LOWER>(x) : x;
+                y = second_goes_right ? second_child<LOWER>(y) : y;
+            }
+            // both edges are below each other's lines, so they cross between them: if they cross on the first side of the
+            // separator, the bridge cannot start before the first edge, otherwise it cannot end after the second one.
+            // a vertical first edge is only before the bridge if the bridge is not vertical itself, on the separator
+            else if (a.get_x() == b.get_x() ? a.get_x() != separator : above_at(a, b, c, d, separator))
+            {
+                x = second_child<LOWER>(x);
+            }
+            else
+            {
+                y = first_child<LOWER>(y);
+            }
+        }
+    }
+
+    /**
+     * @brief Recompute the height, extremes and bridges of an internal node from its children
+     *
+     * @param node
+     */
+    void update(size_t node)
+    {
+        size_t left = nodes[node].left, right = nodes[node].right;
+        nodes[node].height = 1 + std::max(nodes[left].height, nodes[right].height);
+        nodes[node].min = nodes[left].min;
+        nodes[node].max = nodes[right].max;
+        nodes[node].upper = find_bridge<false>(node);
+        nodes[node].lower = find_bridge<true>(node);
+    }
+
+    size_t allocate_node()
+    {
+        if (!free_nodes.empty())
+        {
+            size_t node = free_nodes.back();
+            free_nodes.pop_back();
+            return node;
+        }
+        nodes.emplace_back();
+        return nodes.size() - 1;
+    }
+
+    size_t make_leaf(Point p)
+    {
+        size_t node = allocate_node();
+        nodes[node].left = nodes[node].right = NO_NODE;
+        nodes[node].height = 1;
+        nodes[node].min = p;
+        nodes[node].max = p;
+        nodes[node].upper = Bridge{p, p};
+        nodes[node].lower = Bridge{p, p};
+        return node;
+    }
+
+    size_t make_internal(size_t left, size_t right)
+    {
+        size_t node = allocate_node();
+        nodes[node].left = left;
+        nodes[node].right = right;
+        update(node);
+        return node;
+    }
+
+    size_t rotate_right(size_t node)
+    {
+        size_t left = nodes[node].left;
+        nodes[node].left = nodes[left].right;
+        update(node);
+        nodes[left].right = node;
+        update(left);
+        return left;
+    }
+
+    size_t rotate_left(size_t node)
+    {
+        size_t right = nodes[node].right;
+        nodes[node].right = nodes[right].left;
+        update(node);
+        nodes[right].left = node;
+        update(right);
+        return right;
+    }
+
+    /**
+     * @brief Update an internal node whose children changed, rotating it if they are out of balance
+     *
+     * @param node
+     * @return size_t the root of the subtree
+     */
+    size_t rebalance(size_t node)
+    {
+        size_t left = nodes[node].left, right = nodes[node].right;
+        int balance = height(left) - height(right);
+        if (balance > 1)
+        {
+            if (height(nodes[left].left) < height(nodes[left].right))
+            {
+                nodes[node].left = rotate_left(left);
+            }
+            return rotate_right(node);
+        }
+        if (balance < -1)
+        {
+            if (height(nodes[right].right) < height(nodes[right].left))
+            {
+                nodes[node].right = rotate_right(right);
+            }
+            return rotate_left(node);
+        }
+        update(node);
+        return node;
+    }
+
+    size_t insert_into(size_t node, Point p, bool &inserted)
+    {
+        if (is_leaf(node))
+        {
+            Point q = nodes[node].min;
+            if (q == p)
+            {
+                return node;
+            }
+            inserted = true;
+            size_t leaf = make_leaf(p);
+            return q < p ? make_internal(node, leaf) : make_internal(leaf, node);
+        }
+
+        if (nodes[nodes[node].left].max < p)
+        {
+            size_t right = insert_into(nodes[node].right, p, inserted);
+            nodes[node].right = right;
+        }
+        else
+        {
+            size_t left = insert_into(nodes[node].left, p, inserted);
+            nodes[node].left = left;
+        }
+        return inserted ? rebalance(node) : node;
+    }
+
+    /**
+     * @brief Build a balanced subtree over a range of sorted, distinct points
+     *
+     * @param points
+     * @param begin
+     * @param end
+     * @return size_t the root of the subtree
+     */
+    size_t build(const std::vector<Point> &points, size_t begin, size_t end)
+    {
+        if (end - begin == 1)
+        {
+            return make_leaf(points[begin]);
+        }
+        size_t middle = begin + (end - begin) / 2;
+        size_t left = build(points, begin, middle);
+        size_t right = build(points, middle, end);
+        return make_internal(left, right);
+    }
+
+    size_t erase_from(size_t node, Point p, bool &erased)
+    {
+        if (is_leaf(node))
+        {
+            if (nodes[node].min != p)
+            {
+                return node;
+            }
+            erased = true;
+            free_nodes.push_back(node);
+            return NO_NODE;
+        }
+
+        bool go_right = nodes[nodes[node].left].max < p;
+        size_t child = erase_from(go_right ? nodes[node].right : nodes[node].left, p, erased);
+        if (!erased)
+        {
+            return node;
+        }
+        if (child == NO_NODE)
+        {
+            // the parent of a removed leaf is replaced by the other child
+            free_nodes.push_back(node);
+            return go_right ? nodes[node].left : nodes[node].right;
+        }
+        (go_right ? nodes[node].right : nodes[node].left) = child;
+        return rebalance(node);
+    }
+
+    /**
+     * @brief Check if a point comes before another one along a chain
+     *
+     * @tparam LOWER the chain
+     * @param p
+     * @param q
+     * @return true if p comes strictly before q
+     * @return false otherwise
+     */
+    template <bool LOWER>
+    static bool precedes(Point p, Point q)
+    {
+        return LOWER ? q < p : p < q;
+    }
+
+    /**
+     * @brief Append the vertices of the chain of a subtree that lie between two of them, in chain order
+     * the chain of a node is the chain of its first child up to the bridge, followed by the chain of its second child from
+     * the bridge on, so every visited node adds at least one vertex
+     *
+     * @tparam LOWER the chain
+     * @param node
+     * @param from the first vertex to report
+     * @param to the last vertex to report
+     * @param chain the output
+     */
+    template <bool LOWER>
+    void report_chain(size_t node, Point from, Point to, std::vector<Point> &chain) const
+    {
+        if (is_leaf(node))
+        {
+            Point p = nodes[node].min;
+            if (!precedes<LOWER>(p, from) && !precedes<LOWER>(to, p))
+            {
+                chain.push_back(p);
+            }
+            return;
+        }
+
+        const Bridge &joint = bridge<LOWER>(node);
+        if (!precedes<LOWER>(joint.first, from))
+        {
+            report_chain<LOWER>(first_child<LOWER>(node), from, precedes<LOWER>(to, joint.first) ? to : joint.first, chain);
+        }
+        if (!precedes<LOWER>(to, joint.second))
+        {
+            report_chain<LOWER>(second_child<LOWER>(node), precedes<LOWER>(from, joint.second) ? joint.second : from, to, chain);
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new empty Dynamic Hull object
+     */
+    DynamicHull() : root(NO_NODE), count(0)
+    {
+    }
+
+    /**
+     * @brief Construct a new Dynamic Hull object from a set of points in O(n * log(n)), duplicates are only kept once
+     *
+     * @param points
+     */
+    explicit DynamicHull(std::vector<Point> points) : DynamicHull()
+    {
+        std::sort(points.begin(), points.end());
+        points.erase(std::unique(points.begin(), points.end()), points.end());
+        nodes.reserve(2 * points.size());
+        if (!points.empty())
+        {
+            root = build(points, 0, points.size());
+        }
+        count = points.size();
+    }
+
+    /**
+     * @brief Insert a point
+     *
+     * @param p
+     * @return true if the point was inserted
+     * @return false if it was already in the set
+     */
+    bool insert(Point p)
+    {
+        if (root == NO_NODE)
+        {
+            root = make_leaf(p);
+            count = 1;
+            return true;
+        }
+        bool inserted = false;
+        root = insert_into(root, p, inserted);
+        count += inserted ? 1u : 0u;
+        return inserted;
+    }
+
+    /**
+     * @brief Remove a point
+     *
+     * @param p
+     * @return true if the point was removed
+     * @return false if it was not in the set
+     */
+    bool erase(Point p)
+    {
+        if (root == NO_NODE)
+        {
+            return false;
+        }
+        bool erased = false;
+        root = erase_from(root, p, erased);
+        count -= erased ? 1u : 0u;
+        return erased;
+    }
+
+    /**
+     * @brief Check if a point is in the set
+     *
+     * @param p
+     * @return true if it is
+     * @return false otherwise
+     */
+    bool contains(Point p) const
+    {
+        if (root == NO_NODE)
+        {
+            return false;
+        }
+        size_t node = root;
+        while (!is_leaf(node))
+        {
+            node = nodes[nodes[node].left].max < p ? nodes[node].right : nodes[node].left;
+        }
+        return nodes[node].min == p;
+    }
+
+    /**
+     * @brief Get the convex hull of the current set in O(h * log(n))
+     * the vertices are in counter-clockwise order starting from the lowest leftmost point, without collinear vertices
+     *
+     * @return std::vector<Point>
+     */
+    std::vector<Point> hull() const
+    {
+        std::vector<Point> vertices;
+        if (root == NO_NODE)
+        {
+            return vertices;
+        }
+        if (count == 1)
+        {
+            vertices.push_back(nodes[root].min);
+            return vertices;
+        }
+
+        // the upper chain runs from the lowest leftmost point to the highest rightmost one, and the lower chain back
+        Point min = nodes[root].min, max = nodes[root].max;
+        report_chain<false>(root, min, max, vertices);
+        vertices.pop_back();
+        report_chain<true>(root, max, min, vertices);
+        vertices.pop_back();
+        std::reverse(vertices.begin() + 1, vertices.end());
+        return vertices;
+    }
+
+    /**
+     * @brief Get the number of points in the set
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * @brief Check if the set is empty
+     *
+     * @return true if there are no points
+     * @return false otherwise
+     */
+    bool empty() const
+    {
+        return count == 0;
+    }
+};
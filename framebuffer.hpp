@@ -0,0 +1,334 @@
+/**
+ * @file framebuffer.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief A contiguous palette-indexed image, with clipped point stamping and Bresenham line drawing
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#define FRAMEBUFFER_ALIGNMENT 64
+#define PALETTE_SIZE 256
+
+/**
+ * @brief The palette indices used by the visualizer, the same codes the image arrays use
+ */
+#define BACKGROUND_COLOR 0
+#define POINT_COLOR 1
+#define LINE_COLOR 2
+
+/**
+ * @brief A color, as red, green and blue bytes
+ */
+struct Color
+{
+    uint8_t red, green, blue;
+};
+
+/**
+ * @brief A class to store an image as one aligned array with one palette index byte per pixel
+ * the pixel (x, y) is at pixels[y * width + x], and the row y = 0 is the bottom row, as in a bitmap file
+ */
+class Framebuffer
+{
+private:
+    uint8_t *pixels;
+    uint64_t width, height;
+
+    /**
+     * @brief The color of every palette index, white, black and red for the visualizer's colors and black for the others
+     */
+    std::array<Color, PALETTE_SIZE> palette;
+
+    /**
+     * @brief Allocate an aligned array of pixels
+     *
+     * @param size the number of pixels
+     * @return uint8_t*
+     */
+    static uint8_t *allocate(uint64_t size)
+    {
+        if (size == 0)
+        {
+            return nullptr;
+        }
+        return static_cast<uint8_t *>(::operator new(size, std::align_val_t(FRAMEBUFFER_ALIGNMENT)));
+    }
+
+    /**
+     * @brief Free an array allocated with allocate
+     *
+     * @param array
+     */
+    static void deallocate(uint8_t *array)
+    {
+        if (array != nullptr)
+        {
+            ::operator delete(array, std::align_val_t(FRAMEBUFFER_ALIGNMENT));
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new Framebuffer object filled with the background color
+     *
+     * @param width_to_set
+     * @param height_to_set
+     */
+    Framebuffer(uint64_t width_to_set, uint64_t height_to_set)
+        : pixels(allocate(width_to_set * height_to_set)), width(width_to_set), height(height_to_set)
+    {
+        palette.fill(Color{0, 0, 0});
+        palette[BACKGROUND_COLOR] = Color{255, 255, 255};
+        palette[POINT_COLOR] = Color{0, 0, 0};
+        palette[LINE_COLOR] = Color{255, 0, 0};
+        clear();
+    }
+
+    Framebuffer(const Framebuffer &other)
+        : pixels(allocate(other.width * other.height)), width(other.width), height(other.height), palette(other.palette)
+    {
+        std::copy(other.pixels, other.pixels + width * height, pixels);
+    }
+
+    Framebuffer(Framebuffer &&other) noexcept
+        : pixels(other.pixels), width(other.width), height(other.height), palette(other.palette)
+    {
+        other.pixels = nullptr;
+        other.width = other.height = 0;
+    }
+
+    Framebuffer &operator=(Framebuffer other) noexcept
+    {
+        std::swap(pixels, other.pixels);
+        std::swap(width, other.width);
+        std::swap(height, other.height);
+        std::swap(palette, other.palette);
+        return *this;
+    }
+
+    ~Framebuffer()
+    {
+        deallocate(pixels);
+    }
+
+    uint64_t get_width() const
+    {
+        return width;
+    }
+
+    uint64_t get_height() const
+    {
+        return height;
+    }
+
+    /**
+     * @brief Get the pixels of a row
+     *
+     * @param y
+     * @return const uint8_t* the width palette indices of the row
+     */
+    const uint8_t *row(uint64_t y) const
+    {
+        return pixels + y * width;
+    }
+
+    /**
+     * @brief Get the palette index of a pixel, which must be inside the image
+     *
+     * @param x
+     * @param y
+     * @return uint8_t
+     */
+    uint8_t get(uint64_t x, uint64_t y) const
+    {
+        return pixels[y * width + x];
+    }
+
+    /**
+     * @brief Set a pixel, ignoring the ones outside the image
+     *
+     * @param x
+     * @param y
+     * @param color the palette index
+     */
+    void set(int64_t x, int64_t y, uint8_t color)
+    {
+        if (x >= 0 && y >= 0 && (uint64_t)x < width && (uint64_t)y < height)
+        {
+            pixels[(uint64_t)y * width + (uint64_t)x] = color;
+        }
+    }
+
+    /**
+     * @brief Get the color of a palette index
+     *
+     * @param index
+     * @return Color
+     */
+    Color get_color(uint8_t index) const
+    {
+        return palette[index];
+    }
+
+    /**
+     * @brief Change the color of a palette index
+     *
+     * @param index
+     * @param color
+     */
+    void set_color(uint8_t index, Color color)
+    {
+        palette[index] = color;
+    }
+
+    /**
+     * @brief Fill the whole image with one palette index
+     *
+     * @param color
+     */
+    void clear(uint8_t color = BACKGROUND_COLOR)
+    {
+        std::fill(pixels, pixels + width * height, color);
+    }
+
+    /**
+     * @brief Fill the square of the given radius around a pixel, clipped to the image
+     *
+     * @param x
+     * @param y
+     * @param radius 0 for a single pixel
+     * @param color the palette index
+     */
+    void stamp(int64_t x, int64_t y, int64_t radius, uint8_t color)
+    {
+        int64_t first_x = std::max(x - radius, (int64_t)0), last_x = std::min(x + radius, (int64_t)width - 1);
+        int64_t first_y = std::max(y - radius, (int64_t)0), last_y = std::min(y + radius, (int64_t)height - 1);
+        for (int64_t j = first_y; j <= last_y; j++)
+        {
+            for (int64_t i = first_x; i <= last_x; i++)
+            {
+                pixels[(uint64_t)j * width + (uint64_t)i] = color;
+            }
+        }
+    }
+
+    /**
+     * @brief Clip a segment to a rectangle with the Liang-Barsky algorithm
+     * an endpoint inside the rectangle is kept as is, one outside of it is moved along the segment to the nearest pixel
+     * of where the segment crosses the rectangle
+     *
+     * @param x0
+     * @param y0
+     * @param x1
+     * @param y1
+     * @param min_x the smallest x coordinate of the rectangle
+     * @param min_y the smallest y coordinate of the rectangle
+     * @param max_x the largest x coordinate of the rectangle
+     * @param max_y the largest y coordinate of the rectangle
+     * @return true if some of the segment is in the rectangle
+     * @return false otherwise, the endpoints are left unchanged
+     */
+    static bool clip_segment(int64_t &x0, int64_t &y0, int64_t &x1, int64_t &y1, int64_t min_x, int64_t min_y, int64_t max_x, int64_t max_y)
+    {
+        double dx = (double)x1 - (double)x0, dy = (double)y1 - (double)y0;
+        // the segment is x0 + t * dx for t in [0, 1], and each side of the rectangle keeps the t with p * t <= q
+        const double p[4] = {-dx, dx, -dy, dy};
+        const double q[4] = {(double)x0 - (double)min_x, (double)max_x - (double)x0, (double)y0 - (double)min_y, (double)max_y - (double)y0};
+        double enter = 0, leave = 1;
+        for (size_t side = 0; side < 4; side++)
+        {
+            if (p[side] == 0)
+            {
+                if (q[side] < 0)
+                {
+                    return false;
+                }
+            }
+            else if (p[side] < 0)
+            {
+                enter = std::max(enter, q[side] / p[side]);
+            }
+            else
+            {
+                leave = std::min(leave, q[side] / p[side]);
+            }
+        }
+        if (enter > leave)
+        {
+            return false;
+        }
+        int64_t start_x = x0, start_y = y0;
+        if (leave < 1)
+        {
+            x1 = start_x + std::llround(leave * dx);
+            y1 = start_y + std::llround(leave * dy);
+        }
+        if (enter > 0)
+        {
+            x0 = start_x + std::llround(enter * dx);
+            y0 = start_y + std::llround(enter * dy);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Draw a line between two pixels with Bresenham's algorithm, clipped to the image
+     * the line is first clipped to the image widened by the radius, so the loop only walks the pixels that can be drawn, and
+     * then steps one pixel along its major axis at a time with integer arithmetic only, so steep lines have no gaps
+     *
+     * @param x0
+     * @param y0
+     * @param x1
+     * @param y1
+     * @param radius the radius of the square stamped at every pixel of the line, 0 for a thin line
+     * @param color the palette index
+     */
+    void draw_line(int64_t x0, int64_t y0, int64_t x1, int64_t y1, int64_t radius, uint8_t color)
+    {
+        if (!clip_segment(x0, y0, x1, y1, -radius, -radius, (int64_t)width - 1 + radius, (int64_t)height - 1 + radius))
+        {
+            return;
+        }
+        int64_t dx = std::llabs(x1 - x0), dy = -std::llabs(y1 - y0);
+        int64_t step_x = x0 < x1 ? 1 : -1, step_y = y0 < y1 ? 1 : -1;
+        int64_t error = dx + dy;
+        while (true)
+        {
+            if (radius == 0)
+            {
+                set(x0, y0, color);
+            }
+            else
+            {
+                stamp(x0, y0, radius, color);
+            }
+            if (x0 == x1 && y0 == y1)
+            {
+                return;
+            }
+            int64_t doubled = 2 * error;
+            if (doubled >= dy)
+            {
+                error += dy;
+                x0 += step_x;
+            }
+            if (doubled <= dx)
+            {
+                error += dx;
+                y0 += step_y;
+            }
+        }
+    }
+};
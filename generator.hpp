@@ -0,0 +1,219 @@
+/**
+ * @file generator.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief A seeded, parallel generator of point sets following the distributions that stress the convex hull engines
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+#include "geometry.hpp"
+#include "point_buffer.hpp"
+#include "thread_pool.hpp"
+
+#define GENERATOR_GRAIN_SIZE 65536
+#define CLUSTER_COUNT 16
+#define CLUSTER_DEVIATION 0.02
+#define GAUSSIAN_DEVIATION 0.15
+#define DUPLICATE_POOL_SIZE 64
+
+/**
+ * @brief The distributions a point set can be generated from
+ */
+enum class PointDistribution
+{
+    /**
+     * @brief Uniform in the unit square, the hull has O(log(n)) points
+     */
+    UNIFORM_SQUARE,
+
+    /**
+     * @brief Uniform in the disk inscribed in the unit square, the hull has O(n^(1/3)) points
+     */
+    UNIFORM_DISK,
+
+    /**
+     * @brief On the circle inscribed in the unit square, every point is on the hull
+     */
+    CIRCLE,
+
+    /**
+     * @brief Normal around the center of the unit square, with a deviation of GAUSSIAN_DEVIATION
+     */
+    GAUSSIAN,
+
+    /**
+     * @brief Normal around CLUSTER_COUNT random centers, with a deviation of CLUSTER_DEVIATION
+     */
+    CLUSTERED,
+
+    /**
+     * @brief Drawn from a pool of DUPLICATE_POOL_SIZE random points, so almost every point is a duplicate
+     */
+    DUPLICATES,
+
+    /**
+     * @brief On the diagonal of the unit square, so the hull is a segment
+     */
+    COLLINEAR
+};
+
+/**
+ * @brief The SplitMix64 finalizer, a bijective mix of the bits of a 64-bit integer
+ *
+ * @param value
+ * @return uint64_t
+ */
+inline uint64_t mix_bits(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Counter-based random bits: the bits only depend on the seed, the counter and the stream, so any point can be
+ * generated on its own, by any thread, in any order
+ *
+ * @param seed
+ * @param counter
+ * @param stream one of the independent streams of random bits of a counter
+ * @return uint64_t
+ */
+inline uint64_t random_bits(uint64_t seed, uint64_t counter, uint64_t stream)
+{
+    return mix_bits(mix_bits(seed) ^ mix_bits(4 * counter + stream));
+}
+
+/**
+ * @brief A uniform random double in [0, 1), using the 53 bits of precision of a double
+ *
+ * @param seed
+ * @param counter
+ * @param stream
+ * @return double
+ */
+inline double random_unit(uint64_t seed, uint64_t counter, uint64_t stream)
+{
+    return (double)(random_bits(seed, counter, stream) >> 11) * 0x1.0p-53;
+}
+
+/**
+ * @brief A pair of independent standard normal doubles, with the Box-Muller transform
+ *
+ * @param seed
+ * @param counter
+ * @return Point the two doubles, as the coordinates of a point
+ */
+inline Point random_normal_pair(uint64_t seed, uint64_t counter)
+{
+    // shifted into (0, 1] so the logarithm is finite
+    double radius = std::sqrt(-2 * std::log(1 - random_unit(seed, counter, 0)));
+    double angle = 2 * std::numbers::pi * random_unit(seed, counter, 1);
+    return Point(radius * std::cos(angle), radius * std::sin(angle));
+}
+
+/**
+ * @brief Generate one point of a set
+ * the clusters and the pool of duplicates are drawn from the same seed, under counters that no point uses
+ *
+ * @param distribution
+ * @param seed
+ * @param index the index of the point in the set
+ * @return Point
+ */
+Point generate_point(PointDistribution distribution, uint64_t seed, uint64_t index)
+{
+    switch (distribution)
+    {
+    case PointDistribution::UNIFORM_DISK:
+    {
+        double radius = 0.5 * std::sqrt(random_unit(seed, index, 0)), angle = 2 * std::numbers::pi * random_unit(seed, index, 1);
+        return Point(0.5 + radius * std::cos(angle), 0.5 + radius * std::sin(angle));
+    }
+    case PointDistribution::CIRCLE:
+    {
+        double angle = 2 * std::numbers::pi * random_unit(seed, index, 0);
+        return Point(0.5 + 0.5 * std::cos(angle), 0.5 + 0.5 * std::sin(angle));
+    }
+    case PointDistribution::GAUSSIAN:
+    {
+        Point normal = random_normal_pair(seed, index);
+        return Point(0.5 + GAUSSIAN_DEVIATION * normal.get_x(), 0.5 + GAUSSIAN_DEVIATION * normal.get_y());
+    }
+    case PointDistribution::CLUSTERED:
+    {
+        uint64_t cluster = UINT64_MAX - random_bits(seed, index, 2) % CLUSTER_COUNT;
+        Point normal = random_normal_pair(seed, index);
+        return Point(0.1 + 0.8 * random_unit(seed, cluster, 0) + CLUSTER_DEVIATION * normal.get_x(),
+                     0.1 + 0.8 * random_unit(seed, cluster, 1) + CLUSTER_DEVIATION * normal.get_y());
+    }
+    case PointDistribution::DUPLICATES:
+    {
+        uint64_t original = UINT64_MAX - random_bits(seed, index, 2) % DUPLICATE_POOL_SIZE;
+        return Point(random_unit(seed, original, 0), random_unit(seed, original, 1));
+    }
+    case PointDistribution::COLLINEAR:
+    {
+        double t = random_unit(seed, index, 0);
+        return Point(t, t);
+    }
+    default:
+        return Point(random_unit(seed, index, 0), random_unit(seed, index, 1));
+    }
+}
+
+/**
+ * @brief Fill a structure-of-arrays buffer with a generated point set, in parallel
+ * every point only depends on the seed and its index, so the set is the same whatever the number of threads
+ *
+ * @param points the buffer, resized to count points
+ * @param count the number of points
+ * @param distribution
+ * @param seed
+ * @param pool the pool generating the chunks
+ * @param grain_size the minimum number of points in a chunk
+ */
+void generate_points(PointBuffer &points, size_t count, PointDistribution distribution, uint64_t seed, ThreadPool &pool = default_thread_pool(), size_t grain_size = GENERATOR_GRAIN_SIZE)
+{
+    points.resize(count);
+    double *xs = points.x(), *ys = points.y();
+    parallel_chunks(pool, 0, count, parallel_chunk_count(pool, count, grain_size), [&](size_t, size_t chunk_begin, size_t chunk_end)
+                    {
+        for (size_t i = chunk_begin; i < chunk_end; i++)
+        {
+            Point p = generate_point(distribution, seed, i);
+            xs[i] = p.get_x();
+            ys[i] = p.get_y();
+        } });
+}
+
+/**
+ * @brief Generate a point set, in parallel
+ *
+ * @param count the number of points
+ * @param distribution
+ * @param seed
+ * @param pool the pool generating the chunks
+ * @param grain_size the minimum number of points in a chunk
+ * @return std::vector<Point>
+ */
+std::vector<Point> generate_points(size_t count, PointDistribution distribution, uint64_t seed, ThreadPool &pool = default_thread_pool(), size_t grain_size = GENERATOR_GRAIN_SIZE)
+{
+    std::vector<Point> points(count);
+    parallel_chunks(pool, 0, count, parallel_chunk_count(pool, count, grain_size), [&](size_t, size_t chunk_begin, size_t chunk_end)
+                    {
+        for (size_t i = chunk_begin; i < chunk_end; i++)
+        {
+            points[i] = generate_point(distribution, seed, i);
+        } });
+    return points;
+}
@@ -12,19 +12,26 @@
 
 #include <iostream>
 #include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 using namespace std;
 
 /**
  * @brief A class to store a 2d point data and perform operations on it
+ *
+ * @tparam T the type of the coordinates, double or an integer type of at most 32 bits
  */
-class Point
+template <typename T>
+class BasicPoint
 {
 private:
     /**
      * @brief The points' coordinates in 2d
      */
-    double x, y;
+    T x, y;
 
     /**
      * @brief Set the coordinates object
@@ -32,7 +39,7 @@ private:
      * @param X first coordinate of the point
      * @param Y second coordinate of the point
      */
-    void set_coordinates(double x_to_set, double y_to_set)
+    void set_coordinates(T x_to_set, T y_to_set)
     {
         set_x(x_to_set);
         set_y(y_to_set);
@@ -43,7 +50,7 @@ private:
      *
      * @param X
      */
-    void set_x(double x_to_set)
+    void set_x(T x_to_set)
     {
         x = x_to_set;
     }
@@ -53,7 +60,7 @@ private:
      *
      * @param Y
      */
-    void set_y(double y_to_set)
+    void set_y(T y_to_set)
     {
         y = y_to_set;
     }
@@ -64,7 +71,7 @@ public:
      * initiates with (0, 0)
      *
      */
-    Point()
+    BasicPoint()
     {
         set_coordinates(0, 0);
     }
@@ -75,7 +82,7 @@ public:
      * @param X
      * @param Y
      */
-    Point(double x_to_set, double y_to_set)
+    BasicPoint(T x_to_set, T y_to_set)
     {
         set_coordinates(x_to_set, y_to_set);
     }
@@ -85,7 +92,7 @@ public:
      *
      * @return x's value
      */
-    double get_x()
+    T get_x() const
     {
         return x;
     }
@@ -95,7 +102,7 @@ public:
      *
      * @return y's value
      */
-    double get_y()
+    T get_y() const
     {
         return y;
     }
@@ -106,12 +113,12 @@ public:
      * @param other
      * @return double
      */
-    double distance_to(Point other)
+    double distance_to(BasicPoint other) const
     {
-        double this_x = get_x(),
-               this_y = get_y(),
-               other_x = other.get_x(),
-               other_y = other.get_y();
+        double this_x = (double)get_x(),
+               this_y = (double)get_y(),
+               other_x = (double)other.get_x(),
+               other_y = (double)other.get_y();
         return sqrt(pow(other_x - this_x, 2) + pow(other_y - this_y, 2));
     }
 
@@ -120,15 +127,15 @@ public:
      *  *
      * @param other
      */
-    void operator=(const Point &other)
+    void operator=(const BasicPoint &other)
     {
         set_coordinates(other.x, other.y);
     }
 
     // keep the default behavior for other assignment operations
-    Point(const Point &) = default;
-    Point(Point &&) = default;
-    Point &operator=(Point &&) = default;
+    BasicPoint(const BasicPoint &) = default;
+    BasicPoint(BasicPoint &&) = default;
+    BasicPoint &operator=(BasicPoint &&) = default;
 
     /**
      * @brief overload equality operator
@@ -137,7 +144,7 @@ public:
      * @return true if two points are the same
      * @return false otherwise
      */
-    bool operator==(Point other)
+    bool operator==(BasicPoint other) const
     {
         return (get_x() == other.get_x()) && (get_y() == other.get_y());
     }
@@ -149,7 +156,7 @@ public:
      * @return true if two points are not the same
      * @return false otherwise
      */
-    bool operator!=(Point other)
+    bool operator!=(BasicPoint other) const
     {
         return (get_x() != other.get_x()) || (get_y() != other.get_y());
     }
@@ -158,26 +165,220 @@ public:
      * @brief overload subtraction operator
      *
      * @param other another point
-     * @return Point
+     * @return BasicPoint
      */
-    Point operator-(Point other)
+    BasicPoint operator-(BasicPoint other) const
     {
-        return Point(get_x() - other.get_x(), get_y() - other.get_y());
+        return BasicPoint(get_x() - other.get_x(), get_y() - other.get_y());
     }
 
-    friend std::ostream &operator<<(std::ostream &out, Point p);
+    /**
+     * @brief overload less than operator, comparing the points lexicographically (x first, then y)
+     *
+     * @param other
+     * @return true if this point comes before the other point
+     * @return false otherwise
+     */
+    bool operator<(BasicPoint other) const
+    {
+        return (get_x() < other.get_x()) || (get_x() == other.get_x() && get_y() < other.get_y());
+    }
 };
 
+/**
+ * @brief A point with double coordinates, the one used by every engine
+ */
+using Point = BasicPoint<double>;
+
+/**
+ * @brief A point with 32-bit integer coordinates, half the size of a Point, whose orientation tests are exact
+ */
+using IntPoint = BasicPoint<int32_t>;
+
+/**
+ * @brief Get the cross product of the vectors o->a and o->b
+ *
+ * @param o the common origin of the two vectors
+ * @param a end of the first vector
+ * @param b end of the second vector
+ * @return positive if o, a, b make a counter-clockwise turn, negative if clockwise, zero if collinear
+ */
+double cross_product(Point o, Point a, Point b)
+{
+    return (a.get_x() - o.get_x()) * (b.get_y() - o.get_y()) - (a.get_y() - o.get_y()) * (b.get_x() - o.get_x());
+}
+
+/**
+ * @brief The relative error bound of cross_product: when the computed cross product is larger than this times the sum of
+ * the magnitudes of its two products, its sign is correct (Shewchuk, Adaptive Precision Floating-Point Arithmetic and Fast
+ * Robust Geometric Predicates)
+ */
+#define ORIENT2D_ERROR_BOUND ((3.0 + 16.0 * 0x1.0p-53) * 0x1.0p-53)
+#define ORIENT2D_EXPANSION_SIZE 12
+
+/**
+ * @brief Add two doubles exactly: sum + error is a + b, with sum the rounded result
+ *
+ * @param a
+ * @param b
+ * @param sum
+ * @param error
+ */
+inline void two_sum(double a, double b, double &sum, double &error)
+{
+    sum = a + b;
+    double b_virtual = sum - a, a_virtual = sum - b_virtual;
+    error = (a - a_virtual) + (b - b_virtual);
+}
+
+/**
+ * @brief Multiply two doubles exactly: product + error is a * b, with product the rounded result
+ *
+ * @param a
+ * @param b
+ * @param product
+ * @param error
+ */
+inline void two_product(double a, double b, double &product, double &error)
+{
+    product = a * b;
+    error = std::fma(a, b, -product);
+}
+
+/**
+ * @brief Get the exact sign of the cross product of the vectors o->a and o->b
+ * the cross product is expanded into six products of the coordinates, which are split exactly into their rounded values
+ * and errors, and summed into an expansion: a sum of non-overlapping doubles of increasing magnitude, whose sign is
+ * the sign of its largest component
+ *
+ * @param o
+ * @param a
+ * @param b
+ * @return double a value with the exact sign of the cross product, and roughly its magnitude
+ */
+double orient2d_exact(Point o, Point a, Point b)
+{
+    double factors[6][2] = {{a.get_x(), b.get_y()}, {-a.get_y(), b.get_x()}, {b.get_x(), o.get_y()},
+                            {-b.get_y(), o.get_x()}, {o.get_x(), a.get_y()}, {-o.get_y(), a.get_x()}};
+    double expansion[ORIENT2D_EXPANSION_SIZE];
+    size_t length = 0;
+    for (size_t i = 0; i < 6; i++)
+    {
+        double terms[2];
+        two_product(factors[i][0], factors[i][1], terms[1], terms[0]);
+        for (double term : terms)
+        {
+            // grow the expansion by one term, dropping the zero components
+            size_t grown = 0;
+            for (size_t j = 0; j < length; j++)
+            {
+                double error;
+                two_sum(term, expansion[j], term, error);
+                if (error != 0)
+                {
+                    expansion[grown++] = error;
+                }
+            }
+            if (term != 0)
+            {
+                expansion[grown++] = term;
+            }
+            length = grown;
+        }
+    }
+    return length == 0 ? 0 : expansion[length - 1];
+}
+
+/**
+ * @brief Get the orientation of three points, robustly
+ * the cross product is computed in floating point first, and only recomputed exactly when it is too close to zero for
+ * its sign to be trusted, which is rare, so this is barely slower than cross_product
+ *
+ * @param o the common origin of the two vectors
+ * @param a end of the first vector
+ * @param b end of the second vector
+ * @return double positive if o, a, b make a counter-clockwise turn, negative if clockwise, zero if collinear, always with the
+ * exact sign; when the sign is certain the value is the same as cross_product
+ */
+inline double orient2d(Point o, Point a, Point b)
+{
+    double left = (a.get_x() - o.get_x()) * (b.get_y() - o.get_y()), right = (a.get_y() - o.get_y()) * (b.get_x() - o.get_x());
+    double cross = left - right, bound = ORIENT2D_ERROR_BOUND * (std::fabs(left) + std::fabs(right));
+    if (cross > bound || -cross > bound) [[likely]]
+    {
+        return cross;
+    }
+    return orient2d_exact(o, a, b);
+}
+
+/**
+ * @brief A signed 128-bit integer, wide enough for the cross product of points with 32-bit integer coordinates
+ */
+__extension__ typedef __int128 int128_t;
+
+/**
+ * @brief The integer types the cross product of integer points is computed in: the differences of two coordinates
+ * and the products of two differences must never overflow
+ *
+ * @tparam T the type of the coordinates
+ */
+template <std::integral T>
+struct ExactCrossProduct
+{
+    static_assert(sizeof(T) <= 4, "the cross product of coordinates wider than 32 bits does not fit in 128 bits");
+
+    using difference = int64_t;
+    using product = std::conditional_t<sizeof(T) <= 2, int64_t, int128_t>;
+};
+
+/**
+ * @brief Get the exact cross product of the vectors o->a and o->b of integer points
+ *
+ * @tparam T the type of the coordinates
+ * @param o the common origin of the two vectors
+ * @param a end of the first vector
+ * @param b end of the second vector
+ * @return positive if o, a, b make a counter-clockwise turn, negative if clockwise, zero if collinear
+ */
+template <std::integral T>
+inline typename ExactCrossProduct<T>::product cross_product(BasicPoint<T> o, BasicPoint<T> a, BasicPoint<T> b)
+{
+    using difference = typename ExactCrossProduct<T>::difference;
+    using product = typename ExactCrossProduct<T>::product;
+    product left = (product)((difference)a.get_x() - o.get_x()) * (product)((difference)b.get_y() - o.get_y());
+    product right = (product)((difference)a.get_y() - o.get_y()) * (product)((difference)b.get_x() - o.get_x());
+    return left - right;
+}
+
+/**
+ * @brief Get the orientation of three integer points
+ * the cross product of integer points is always exact, so no error bound nor fallback is needed
+ *
+ * @tparam T the type of the coordinates
+ * @param o the common origin of the two vectors
+ * @param a end of the first vector
+ * @param b end of the second vector
+ * @return positive if o, a, b make a counter-clockwise turn, negative if clockwise, zero if collinear
+ */
+template <std::integral T>
+inline typename ExactCrossProduct<T>::product orient2d(BasicPoint<T> o, BasicPoint<T> a, BasicPoint<T> b)
+{
+    return cross_product(o, a, b);
+}
+
 /**
  * @brief A class to store a line data and perform operations on it
+ *
+ * @tparam T the type of the coordinates of its points
  */
-class Line
+template <typename T>
+class BasicLine
 {
 private:
     /**
      * @brief The line's start and end points
      */
-    Point start, end;
+    BasicPoint<T> start, end;
 
     /**
      * @brief Set the line coordinates object
@@ -185,7 +386,7 @@ private:
      * @param start_to_set
      * @param end_to_set
      */
-    void set_line_coordinates(Point start_to_set, Point end_to_set)
+    void set_line_coordinates(BasicPoint<T> start_to_set, BasicPoint<T> end_to_set)
     {
         set_start(start_to_set);
         set_end(end_to_set);
@@ -196,7 +397,7 @@ private:
      *
      * @param start_to_set given start point
      */
-    void set_start(Point start_to_set)
+    void set_start(BasicPoint<T> start_to_set)
     {
         start = start_to_set;
     }
@@ -206,7 +407,7 @@ private:
      *
      * @param end_to_set given end point
      */
-    void set_end(Point end_to_set)
+    void set_end(BasicPoint<T> end_to_set)
     {
         end = end_to_set;
     }
@@ -215,9 +416,9 @@ public:
     /**
      * @brief Construct a new Line object without given input
      */
-    Line()
+    BasicLine()
     {
-        set_line_coordinates(Point(), Point());
+        set_line_coordinates(BasicPoint<T>(), BasicPoint<T>());
     }
 
     /**
@@ -226,7 +427,7 @@ public:
      * @param start_to_set start point of the line
      * @param end_to_set end point of the line
      */
-    Line(Point start_to_set, Point end_to_set)
+    BasicLine(BasicPoint<T> start_to_set, BasicPoint<T> end_to_set)
     {
         set_line_coordinates(start_to_set, end_to_set);
     }
@@ -234,9 +435,9 @@ public:
     /**
      * @brief Get the start point of the line
      *
-     * @return Point
+     * @return BasicPoint<T>
      */
-    Point get_start()
+    BasicPoint<T> get_start()
     {
         return start;
     }
@@ -244,9 +445,9 @@ public:
     /**
      * @brief Get the end point of the line
      *
-     * @return Point
+     * @return BasicPoint<T>
      */
-    Point get_end()
+    BasicPoint<T> get_end()
     {
         return end;
     }
@@ -256,9 +457,9 @@ public:
      *
      * @return reversed line
      */
-    Line reversed_line()
+    BasicLine reversed_line()
     {
-        return Line(end, start);
+        return BasicLine(end, start);
     }
 
     /**
@@ -268,7 +469,7 @@ public:
      */
     double slope()
     {
-        return (end.get_y() - start.get_y()) / (end.get_x() - start.get_x());
+        return ((double)end.get_y() - (double)start.get_y()) / ((double)end.get_x() - (double)start.get_x());
     }
 
     /**
@@ -278,7 +479,7 @@ public:
      */
     double intersection()
     {
-        return end.get_y() - slope() * end.get_x();
+        return (double)end.get_y() - slope() * (double)end.get_x();
     }
 
     /**
@@ -297,14 +498,10 @@ public:
      * @param p the point to calculate the distance from
      * @return distance between the line and the point
      */
-    double distance_from_point(Point p)
+    double distance_from_point(BasicPoint<T> p)
     {
-        double m = slope(), b = intersection();
-        if (isinf(m))
-        {
-            return p.get_x() - get_start().get_x();
-        }
-        return abs(m * p.get_x() - p.get_y() + b) / sqrt(1 + m * m);
+        // the cross product is the area of the parallelogram spanned by the line and the point
+        return std::fabs((double)cross_product(start, end, p)) / length();
     }
 
     /**
@@ -314,21 +511,20 @@ public:
      * @return true if the point is on the left of the line
      * @return false otherwise
      */
-    bool is_point_on_left_of_line(Point p)
+    bool is_point_on_left_of_line(BasicPoint<T> p)
     {
-        double d = (p.get_x() - start.get_x()) * (end.get_y() - start.get_y()) - (p.get_y() - start.get_y()) * (end.get_x() - start.get_x());
-        return d > 0;
+        return orient2d(start, end, p) < 0;
     }
 
     /**
      * @brief overload subtraction operator
      *
      * @param other
-     * @return Line
+     * @return BasicLine
      */
-    Line operator-(Line other)
+    BasicLine operator-(BasicLine other)
     {
-        return Line(get_start() - other.get_start(), get_end() - other.get_end());
+        return BasicLine(get_start() - other.get_start(), get_end() - other.get_end());
     }
 
     /**
@@ -337,17 +533,24 @@ public:
      * @param other
      * @return dot product
      */
-    double operator*(Line other)
+    double operator*(BasicLine other)
     {
-        double x_dot = (get_end() - get_start()).get_x() * (other.get_end() - other.get_start()).get_x();
-        double y_dot = (get_end() - get_start()).get_y() * (other.get_end() - other.get_start()).get_y();
+        double x_dot = ((double)get_end().get_x() - (double)get_start().get_x()) * ((double)other.get_end().get_x() - (double)other.get_start().get_x());
+        double y_dot = ((double)get_end().get_y() - (double)get_start().get_y()) * ((double)other.get_end().get_y() - (double)other.get_start().get_y());
         return (x_dot + y_dot) / (length() * other.length());
     }
-
-    // extraction
-    friend std::ostream &operator<<(std::ostream &out, Point p);
 };
 
+/**
+ * @brief A line between two points with double coordinates
+ */
+using Line = BasicLine<double>;
+
+/**
+ * @brief A line between two points with 32-bit integer coordinates
+ */
+using IntLine = BasicLine<int32_t>;
+
 /**
  * @brief overload insertion operator
  *
@@ -355,7 +558,8 @@ public:
  * @param p The point to get printed
  * @return std::ostream&
  */
-std::ostream &operator<<(std::ostream &out, Point p)
+template <typename T>
+std::ostream &operator<<(std::ostream &out, BasicPoint<T> p)
 {
     out << "(" << p.get_x() << ", " << p.get_y() << ")";
     return out;
@@ -368,7 +572,8 @@ std::ostream &operator<<(std::ostream &out, Point p)
  * @param line
  * @return std::ostream&
  */
-std::ostream &operator<<(std::ostream &out, Line line)
+template <typename T>
+std::ostream &operator<<(std::ostream &out, BasicLine<T> line)
 {
     out << line.get_start() << "->" << line.get_end();
     return out;
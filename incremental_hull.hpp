@@ -0,0 +1,297 @@
+/**
+ * @file incremental_hull.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief An online convex hull that is kept up to date as points are inserted
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <iterator>
+#include <map>
+#include <span>
+#include "geometry.hpp"
+
+/**
+ * @brief The lower hull of a set of points, stored as an ordered map from x to y
+ * the upper hull is handled by the same class, by storing the points with their y negated
+ */
+class HullChain
+{
+private:
+    /**
+     * @brief The vertices of the chain, from left to right
+     */
+    std::map<double, double> vertices;
+
+    /**
+     * @brief Get the point stored at a position of the map
+     *
+     * @param it
+     * @return Point
+     */
+    static Point at(std::map<double, double>::const_iterator it)
+    {
+        return Point(it->first, it->second);
+    }
+
+public:
+    /**
+     * @brief Insert a point into the chain
+     * a point above the chain is rejected with one lookup, otherwise the vertices it makes non-convex are erased
+     *
+     * @param p
+     * @return true if the point became a vertex of the chain
+     * @return false otherwise
+     */
+    bool insert(Point p)
+    {
+        std::map<double, double>::iterator it = vertices.lower_bound(p.get_x());
+        if (it != vertices.end() && it->first == p.get_x())
+        {
+            if (it->second <= p.get_y())
+            {
+                return false;
+            }
+            it->second = p.get_y();
+        }
+        else
+        {
+            // between two vertices, the point must be strictly below the segment joining them
+            if (it != vertices.end() && it != vertices.begin() && orient2d(at(std::prev(it)), at(it), p) >= 0)
+            {
+                return false;
+            }
+            it = vertices.emplace_hint(it, p.get_x(), p.get_y());
+        }
+
+        // the chain must keep turning counter-clockwise on both sides of the new vertex
+        while (std::next(it) != vertices.end() && std::next(it, 2) != vertices.end() && orient2d(p, at(std::next(it)), at(std::next(it, 2))) <= 0)
+        {
+            vertices.erase(std::next(it));
+        }
+        while (it != vertices.begin() && std::prev(it) != vertices.begin() && orient2d(at(std::prev(it, 2)), at(std::prev(it)), p) <= 0)
+        {
+            vertices.erase(std::prev(it));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get the vertices of the chain
+     *
+     * @return const std::map<double, double>&
+     */
+    const std::map<double, double> &get_vertices() const
+    {
+        return vertices;
+    }
+};
+
+/**
+ * @brief A convex hull that accepts point insertions without recomputing
+ * the hull is kept as its lower and upper chains, so an insertion costs amortized O(log(h)), and a point inside the hull
+ * is rejected in O(log(h))
+ */
+class IncrementalHull
+{
+private:
+    HullChain lower, upper;
+
+    /**
+     * @brief Mirror a point across the x axis, to store it in the upper chain
+     *
+     * @param p
+     * @return Point
+     */
+    static Point mirrored(Point p)
+    {
+        return Point(p.get_x(), -p.get_y());
+    }
+
+public:
+    /**
+     * @brief A forward iterator over the hull vertices: the lower chain from left to right, then the upper chain from right to left
+     */
+    class VertexIterator
+    {
+    private:
+        std::map<double, double>::const_iterator lower_it, lower_end;
+        std::map<double, double>::const_reverse_iterator upper_it;
+        size_t upper_remaining;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Point;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Point *;
+        using reference = Point;
+
+        VertexIterator() : upper_remaining(0)
+        {
+        }
+
+        VertexIterator(std::map<double, double>::const_iterator lower_it_to_set, std::map<double, double>::const_iterator lower_end_to_set,
+                       std::map<double, double>::const_reverse_iterator upper_it_to_set, size_t upper_remaining_to_set)
+            : lower_it(lower_it_to_set), lower_end(lower_end_to_set), upper_it(upper_it_to_set), upper_remaining(upper_remaining_to_set)
+        {
+        }
+
+        Point operator*() const
+        {
+            if (lower_it != lower_end)
+            {
+                return Point(lower_it->first, lower_it->second);
+            }
+            return Point(upper_it->first, -upper_it->second);
+        }
+
+        VertexIterator &operator++()
+        {
+            if (lower_it != lower_end)
+            {
+                ++lower_it;
+            }
+            else
+            {
+                ++upper_it;
+                upper_remaining--;
+            }
+            return *this;
+        }
+
+        VertexIterator operator++(int)
+        {
+            VertexIterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const VertexIterator &other) const
+        {
+            return lower_it == other.lower_it && upper_remaining == other.upper_remaining;
+        }
+
+        bool operator!=(const VertexIterator &other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * @brief An ordered view of the hull vertices, valid until the next insertion
+     * the vertices are in counter-clockwise order starting from the lowest leftmost point
+     */
+    class VertexView
+    {
+    private:
+        VertexIterator first, last;
+        size_t count;
+
+    public:
+        VertexView(VertexIterator first_to_set, VertexIterator last_to_set, size_t count_to_set)
+            : first(first_to_set), last(last_to_set), count(count_to_set)
+        {
+        }
+
+        VertexIterator begin() const
+        {
+            return first;
+        }
+
+        VertexIterator end() const
+        {
+            return last;
+        }
+
+        size_t size() const
+        {
+            return count;
+        }
+    };
+
+    /**
+     * @brief Insert a point into the hull
+     *
+     * @param p
+     * @return true if the point became a vertex of the hull
+     * @return false if it was inside the hull, or on its boundary
+     */
+    bool insert(Point p)
+    {
+        bool on_lower = lower.insert(p);
+        bool on_upper = upper.insert(mirrored(p));
+        return on_lower || on_upper;
+    }
+
+    /**
+     * @brief Insert a batch of points into the hull
+     *
+     * @param points
+     * @return size_t the number of points that became vertices of the hull when they were inserted
+     */
+    size_t insert(std::span<const Point> points)
+    {
+        size_t inserted = 0;
+        for (Point p : points)
+        {
+            inserted += insert(p) ? 1u : 0u;
+        }
+        return inserted;
+    }
+
+    /**
+     * @brief Get an ordered view of the hull vertices
+     * the two chains share their leftmost and rightmost vertices, which are only visited once
+     *
+     * @return VertexView
+     */
+    VertexView vertices() const
+    {
+        const std::map<double, double> &lower_vertices = lower.get_vertices(), &upper_vertices = upper.get_vertices();
+        if (lower_vertices.empty())
+        {
+            return VertexView(VertexIterator(), VertexIterator(), 0);
+        }
+
+        std::map<double, double>::const_reverse_iterator upper_first = upper_vertices.rbegin();
+        size_t upper_count = upper_vertices.size();
+        if (upper_first->second == -lower_vertices.rbegin()->second)
+        {
+            upper_first++;
+            upper_count--;
+        }
+        if (upper_count > 0 && upper_vertices.begin()->second == -lower_vertices.begin()->second)
+        {
+            upper_count--;
+        }
+
+        VertexIterator first(lower_vertices.begin(), lower_vertices.end(), upper_first, upper_count);
+        VertexIterator last(lower_vertices.end(), lower_vertices.end(), upper_first, 0);
+        return VertexView(first, last, lower_vertices.size() + upper_count);
+    }
+
+    /**
+     * @brief Get the number of hull vertices
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return vertices().size();
+    }
+
+    /**
+     * @brief Check if no point was inserted
+     *
+     * @return true if the hull is empty
+     * @return false otherwise
+     */
+    bool empty() const
+    {
+        return lower.get_vertices().empty();
+    }
+};
@@ -0,0 +1,591 @@
+/**
+ * @file kernels.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief Vectorized batch kernels over structure-of-arrays points, with AVX2 and SSE2 versions and a scalar fallback
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "geometry.hpp"
+
+// on x86 with GCC or Clang the AVX2 kernels are compiled into every build with the target attribute, and picked at
+// runtime when the processor supports AVX2, so a build without -mavx2 still runs them
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define KERNELS_AVX2
+#define AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// every kernel evaluates the cross product with the same operations as cross_product,
+// (finish - start) x (p - start), so the vector and scalar versions agree bit for bit.
+// classify_points also checks it against the error bound of orient2d, and recomputes the uncertain ones exactly.
+// the kernels read the coordinates of point i at xs[Stride * i] and ys[Stride * i]: a stride of 1 is a structure of
+// arrays, and a stride of 2 is an array of Points, whose coordinates are deinterleaved in registers
+
+#define KERNEL_BLOCK_SIZE 256
+
+/**
+ * @brief Check if the AVX2 kernels are used, because the build targets AVX2 or the processor supports it
+ *
+ * @return true if the AVX2 kernels are used
+ * @return false if the SSE2 or scalar ones are
+ */
+inline bool kernels_use_avx2()
+{
+#if defined(__AVX2__)
+    return true;
+#elif defined(KERNELS_AVX2)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Get the coordinates of an array of Points as one array of doubles, x0, y0, x1, y1, ...
+ *
+ * @param points
+ * @return const double*
+ */
+inline const double *point_coordinates(const Point *points)
+{
+    static_assert(std::is_standard_layout_v<Point> && sizeof(Point) == 2 * sizeof(double), "Point must be two packed doubles");
+    return reinterpret_cast<const double *>(points);
+}
+
+#if defined(KERNELS_AVX2)
+/**
+ * @brief Load the coordinates of the points i to i + 3
+ *
+ * @tparam Stride the distance between the coordinates of two consecutive points
+ * @param xs
+ * @param ys
+ * @param i
+ * @param x output
+ * @param y output
+ */
+template <size_t Stride>
+AVX2_TARGET inline void load_four_points(const double *xs, const double *ys, size_t i, __m256d &x, __m256d &y)
+{
+    if constexpr (Stride == 1)
+    {
+        x = _mm256_loadu_pd(xs + i);
+        y = _mm256_loadu_pd(ys + i);
+    }
+    else
+    {
+        // x0 y0 x1 y1 and x2 y2 x3 y3 unpack to x0 x2 x1 x3 and y0 y2 y1 y3, which are put back in order
+        __m256d low = _mm256_loadu_pd(xs + 2 * i), high = _mm256_loadu_pd(xs + 2 * i + 4);
+        x = _mm256_permute4x64_pd(_mm256_unpacklo_pd(low, high), 0xD8);
+        y = _mm256_permute4x64_pd(_mm256_unpackhi_pd(low, high), 0xD8);
+    }
+}
+#endif
+
+#if defined(__SSE2__)
+/**
+ * @brief Load the coordinates of the points i and i + 1
+ *
+ * @tparam Stride the distance between the coordinates of two consecutive points
+ * @param xs
+ * @param ys
+ * @param i
+ * @param x output
+ * @param y output
+ */
+template <size_t Stride>
+inline void load_two_points(const double *xs, const double *ys, size_t i, __m128d &x, __m128d &y)
+{
+    if constexpr (Stride == 1)
+    {
+        x = _mm_loadu_pd(xs + i);
+        y = _mm_loadu_pd(ys + i);
+    }
+    else
+    {
+        __m128d low = _mm_loadu_pd(xs + 2 * i), high = _mm_loadu_pd(xs + 2 * i + 2);
+        x = _mm_unpacklo_pd(low, high);
+        y = _mm_unpackhi_pd(low, high);
+    }
+}
+#endif
+
+/**
+ * @brief Get the side of a point from its cross product, or from orient2d when the cross product is too close to zero
+ *
+ * @param cross (finish - start) x (p - start)
+ * @param bound ORIENT2D_ERROR_BOUND times the sum of the magnitudes of the two products of the cross product
+ * @param p
+ * @param start
+ * @param finish
+ * @return int8_t 1 on the left, -1 on the right, 0 on the line
+ */
+inline int8_t robust_side(double cross, double bound, Point p, Point start, Point finish)
+{
+    if (!(cross > bound || -cross > bound))
+    {
+        cross = orient2d_exact(start, finish, p);
+    }
+    return (int8_t)((cross > 0) - (cross < 0));
+}
+
+/**
+ * @brief Classify a batch of points against the start->finish line with SSE2, or with scalar code without it
+ *
+ * @tparam Stride the distance between the coordinates of two consecutive points
+ * @param xs x coordinates of the points
+ * @param ys y coordinates of the points
+ * @param count number of points
+ * @param start start point of the line
+ * @param finish end point of the line
+ * @param sides output, 1 for points on the left (counter-clockwise side) of the line, -1 for points on the right, 0 for points on it
+ */
+template <size_t Stride>
+void classify_strided_points_baseline(const double *xs, const double *ys, size_t count, Point start, Point finish, int8_t *sides)
+{
+    double sx = start.get_x(), sy = start.get_y();
+    double dx = finish.get_x() - sx, dy = finish.get_y() - sy;
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    __m128d vsx = _mm_set1_pd(sx), vsy = _mm_set1_pd(sy), vdx = _mm_set1_pd(dx), vdy = _mm_set1_pd(dy);
+    __m128d error_bound = _mm_set1_pd(ORIENT2D_ERROR_BOUND), sign_mask = _mm_set1_pd(-0.0);
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d x, y;
+        load_two_points<Stride>(xs, ys, i, x, y);
+        __m128d px = _mm_sub_pd(x, vsx);
+        __m128d py = _mm_sub_pd(y, vsy);
+        __m128d left = _mm_mul_pd(vdx, py), right = _mm_mul_pd(vdy, px);
+        __m128d cross = _mm_sub_pd(left, right);
+        __m128d bound = _mm_mul_pd(error_bound, _mm_add_pd(_mm_andnot_pd(sign_mask, left), _mm_andnot_pd(sign_mask, right)));
+        int positive = _mm_movemask_pd(_mm_cmpgt_pd(cross, bound));
+        int negative = _mm_movemask_pd(_mm_cmpgt_pd(_mm_xor_pd(cross, sign_mask), bound));
+        for (int k = 0; k < 2; k++)
+        {
+            size_t j = i + (size_t)k;
+            sides[j] = ((positive | negative) >> k) & 1 ? (int8_t)(((positive >> k) & 1) - ((negative >> k) & 1))
+                                                         : robust_side(0, 0, Point(xs[Stride * j], ys[Stride * j]), start, finish);
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        double x = xs[Stride * i], y = ys[Stride * i];
+        double left = dx * (y - sy), right = dy * (x - sx);
+        sides[i] = robust_side(left - right, ORIENT2D_ERROR_BOUND * (std::fabs(left) + std::fabs(right)), Point(x, y), start, finish);
+    }
+}
+
+#if defined(KERNELS_AVX2)
+/**
+ * @brief Classify a batch of points against the start->finish line with AVX2, the processor must support it
+ *
+ * @tparam Stride the distance between the coordinates of two consecutive points
+ * @param xs x coordinates of the points
+ * @param ys y coordinates of the points
+ * @param count number of points
+ * @param start start point of the line
+ * @param finish end point of the line
+ * @param sides output, 1 for points on the left (counter-clockwise side) of the line, -1 for points on the right, 0 for points on it
+ */
+template <size_t Stride>
+AVX2_TARGET void classify_strided_points_avx2(const double *xs, const double *ys, size_t count, Point start, Point finish, int8_t *sides)
+{
+    double sx = start.get_x(), sy = start.get_y();
+    double dx = finish.get_x() - sx, dy = finish.get_y() - sy;
+    size_t i = 0;
+
+    __m256d vsx = _mm256_set1_pd(sx), vsy = _mm256_set1_pd(sy), vdx = _mm256_set1_pd(dx), vdy = _mm256_set1_pd(dy);
+    __m256d error_bound = _mm256_set1_pd(ORIENT2D_ERROR_BOUND), sign_mask = _mm256_set1_pd(-0.0);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256d x, y;
+        load_four_points<Stride>(xs, ys, i, x, y);
+        __m256d px = _mm256_sub_pd(x, vsx);
+        __m256d py = _mm256_sub_pd(y, vsy);
+        __m256d left = _mm256_mul_pd(vdx, py), right = _mm256_mul_pd(vdy, px);
+        __m256d cross = _mm256_sub_pd(left, right);
+        __m256d bound = _mm256_mul_pd(error_bound, _mm256_add_pd(_mm256_andnot_pd(sign_mask, left), _mm256_andnot_pd(sign_mask, right)));
+        int positive = _mm256_movemask_pd(_mm256_cmp_pd(cross, bound, _CMP_GT_OQ));
+        int negative = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_xor_pd(cross, sign_mask), bound, _CMP_GT_OQ));
+        for (int k = 0; k < 4; k++)
+        {
+            size_t j = i + (size_t)k;
+            sides[j] = ((positive | negative) >> k) & 1 ? (int8_t)(((positive >> k) & 1) - ((negative >> k) & 1))
+                                                         : robust_side(0, 0, Point(xs[Stride * j], ys[Stride * j]), start, finish);
+        }
+    }
+
+    classify_strided_points_baseline<Stride>(xs + Stride * i, ys + Stride * i, count - i, start, finish, sides + i);
+}
+#endif
+
+/**
+ * @brief Classify a batch of points against the start->finish line, with the widest kernel the processor supports
+ *
+ * @tparam Stride the distance between the coordinates of two consecutive points
+ * @param xs x coordinates of the points
+ * @param ys y coordinates of the points
+ * @param count number of points
+ * @param start start point of the line
+ * @param finish end point of the line
+ * @param sides output, 1 for points on the left (counter-clockwise side) of the line, -1 for points on the right, 0 for points on it
+ */
+template <size_t Stride>
+void classify_strided_points(const double *xs, const double *ys, size_t count, Point start, Point finish, int8_t *sides)
+{
+#if defined(KERNELS_AVX2)
+    if (kernels_use_avx2())
+    {
+        classify_strided_points_avx2<Stride>(xs, ys, count, start, finish, sides);
+        return;
+    }
+#endif
+    classify_strided_points_baseline<Stride>(xs, ys, count, start, finish, sides);
+}
+
+/**
+ * @brief Check if a candidate beats the best point so far: it is farther, or as far and lexicographically smaller
+ * among points at the same distance, the lexicographically smallest is an end of their segment, so the hull engines
+ * always pick a vertex
+ *
+ * @param cross the cross product of the candidate
+ * @param x
+ * @param y
+ * @param best_cross the cross product of the best point
+ * @param best_x
+ * @param best_y
+ * @return true if the candidate is better
+ * @return false otherwise
+ */
+inline bool farther_point(double cross, double x, double y, double best_cross, double best_x, double best_y)
+{
+    return cross > best_cross || (cross == best_cross && (x < best_x || (x == best_x && y < best_y)));
+}
+
+/**
+ * @brief Update the farthest point of a batch with the points of [begin, count), one at a time
+ *
+ * @tparam Stride the distance between the coordinates of two consecutive points
+ * @param xs x coordinates of the points
+ * @param ys y coordinates of the points
+ * @param begin the first index to scan, the points before it are already scanned
+ * @param count number of points
+ * @param start start point of the line
+ * @param finish end point of the line
+ * @param best the cross product of the farthest point so far
+ * @param best_index the index of the farthest point so far
+ */
+template <size_t Stride>
+void scan_farthest_point(const double *xs, const double *ys, size_t begin, size_t count, Point start, Point finish, double &best, size_t &best_index)
+{
+    double sx = start.get_x(), sy = start.get_y();
+    double dx = finish.get_x() - sx, dy = finish.get_y() - sy;
+    for (size_t i = begin; i < count; i++)
+    {
+        double x = xs[Stride * i], y = ys[Stride * i];
+        double cross = dx * (y - sy) - dy * (x - sx);
+        if (i == 0 || farther_point(cross, x, y, best, xs[Stride * best_index], ys[Stride * best_index]))
+        {
+            best = cross;
+            best_index = i;
+        }
+    }
+}
+
+/**
+ * @brief Find the point of a batch with the largest signed distance on the left of the start->finish line, with SSE2 or
+ * with scalar code without it
+ *
+ * @tparam Stride the distance between the coordinates of two consecutive points
+ * @param xs x coordinates of the points
+ * @param ys y coordinates of the points
+ * @param count number of points, must be positive
+ * @param start start point of the line
+ * @param finish end point of the line
+ * @param max_cross output, the cross product of the farthest point
+ * @return size_t the index of the point with the largest signed distance, the lexicographically smallest one on ties
+ */
+template <size_t Stride>
+size_t farthest_strided_point_baseline(const double *xs, const double *ys, size_t count, Point start, Point finish, double &max_cross)
+{
+    double best = -std::numeric_limits<double>::infinity();
+    size_t best_index = 0, i = 0;
+
+#if defined(__SSE2__)
+    if (count >= 4)
+    {
+        double sx = start.get_x(), sy = start.get_y();
+        double dx = finish.get_x() - sx, dy = finish.get_y() - sy;
+        __m128d vsx = _mm_set1_pd(sx), vsy = _mm_set1_pd(sy), vdx = _mm_set1_pd(dx), vdy = _mm_set1_pd(dy);
+        __m128d lane_best = _mm_set1_pd(best), lane_index = _mm_setzero_pd();
+        __m128d lane_x = _mm_setzero_pd(), lane_y = _mm_setzero_pd();
+        __m128d index = _mm_set_pd(1, 0), step = _mm_set1_pd(2);
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d x, y;
+            load_two_points<Stride>(xs, ys, i, x, y);
+            __m128d px = _mm_sub_pd(x, vsx);
+            __m128d py = _mm_sub_pd(y, vsy);
+            __m128d cross = _mm_sub_pd(_mm_mul_pd(vdx, py), _mm_mul_pd(vdy, px));
+            __m128d smaller = _mm_or_pd(_mm_cmplt_pd(x, lane_x), _mm_and_pd(_mm_cmpeq_pd(x, lane_x), _mm_cmplt_pd(y, lane_y)));
+            __m128d better = _mm_or_pd(_mm_cmpgt_pd(cross, lane_best), _mm_and_pd(_mm_cmpeq_pd(cross, lane_best), smaller));
+            lane_best = _mm_or_pd(_mm_and_pd(better, cross), _mm_andnot_pd(better, lane_best));
+            lane_index = _mm_or_pd(_mm_and_pd(better, index), _mm_andnot_pd(better, lane_index));
+            lane_x = _mm_or_pd(_mm_and_pd(better, x), _mm_andnot_pd(better, lane_x));
+            lane_y = _mm_or_pd(_mm_and_pd(better, y), _mm_andnot_pd(better, lane_y));
+            index = _mm_add_pd(index, step);
+        }
+        double bests[2], indices[2];
+        _mm_storeu_pd(bests, lane_best);
+        _mm_storeu_pd(indices, lane_index);
+        for (int k = 0; k < 2; k++)
+        {
+            size_t lane = (size_t)indices[k];
+            if (k == 0 || farther_point(bests[k], xs[Stride * lane], ys[Stride * lane], best, xs[Stride * best_index], ys[Stride * best_index]))
+            {
+                best = bests[k];
+                best_index = lane;
+            }
+        }
+    }
+#endif
+
+    scan_farthest_point<Stride>(xs, ys, i, count, start, finish, best, best_index);
+    max_cross = best;
+    return best_index;
+}
+
+#if defined(KERNELS_AVX2)
+/**
+ * @brief Find the point of a batch with the largest signed distance on the left of the start->finish line with AVX2, the
+ * processor must support it
+ *
+ * @tparam Stride the distance between the coordinates of two consecutive points
+ * @param xs x coordinates of the points
+ * @param ys y coordinates of the points
+ * @param count number of points, must be positive
+ * @param start start point of the line
+ * @param finish end point of the line
+ * @param max_cross output, the cross product of the farthest point
+ * @return size_t the index of the point with the largest signed distance, the lexicographically smallest one on ties
+ */
+template <size_t Stride>
+AVX2_TARGET size_t farthest_strided_point_avx2(const double *xs, const double *ys, size_t count, Point start, Point finish, double &max_cross)
+{
+    double best = -std::numeric_limits<double>::infinity();
+    size_t best_index = 0, i = 0;
+
+    if (count >= 8)
+    {
+        double sx = start.get_x(), sy = start.get_y();
+        double dx = finish.get_x() - sx, dy = finish.get_y() - sy;
+        __m256d vsx = _mm256_set1_pd(sx), vsy = _mm256_set1_pd(sy), vdx = _mm256_set1_pd(dx), vdy = _mm256_set1_pd(dy);
+        __m256d lane_best = _mm256_set1_pd(best), lane_index = _mm256_setzero_pd();
+        __m256d lane_x = _mm256_setzero_pd(), lane_y = _mm256_setzero_pd();
+        __m256d index = _mm256_set_pd(3, 2, 1, 0), step = _mm256_set1_pd(4);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d x, y;
+            load_four_points<Stride>(xs, ys, i, x, y);
+            __m256d px = _mm256_sub_pd(x, vsx);
+            __m256d py = _mm256_sub_pd(y, vsy);
+            __m256d cross = _mm256_sub_pd(_mm256_mul_pd(vdx, py), _mm256_mul_pd(vdy, px));
+            __m256d smaller = _mm256_or_pd(_mm256_cmp_pd(x, lane_x, _CMP_LT_OQ),
+                                           _mm256_and_pd(_mm256_cmp_pd(x, lane_x, _CMP_EQ_OQ), _mm256_cmp_pd(y, lane_y, _CMP_LT_OQ)));
+            __m256d better = _mm256_or_pd(_mm256_cmp_pd(cross, lane_best, _CMP_GT_OQ),
+                                          _mm256_and_pd(_mm256_cmp_pd(cross, lane_best, _CMP_EQ_OQ), smaller));
+            lane_best = _mm256_blendv_pd(lane_best, cross, better);
+            lane_index = _mm256_blendv_pd(lane_index, index, better);
+            lane_x = _mm256_blendv_pd(lane_x, x, better);
+            lane_y = _mm256_blendv_pd(lane_y, y, better);
+            index = _mm256_add_pd(index, step);
+        }
+        double bests[4], indices[4];
+        _mm256_storeu_pd(bests, lane_best);
+        _mm256_storeu_pd(indices, lane_index);
+        for (int k = 0; k < 4; k++)
+        {
+            size_t lane = (size_t)indices[k];
+            if (k == 0 || farther_point(bests[k], xs[Stride * lane], ys[Stride * lane], best, xs[Stride * best_index], ys[Stride * best_index]))
+            {
+                best = bests[k];
+                best_index = lane;
+            }
+        }
+    }
+
+    scan_farthest_point<Stride>(xs, ys, i, count, start, finish, best, best_index);
+    max_cross = best;
+    return best_index;
+}
+#endif
+
+/**
+ * @brief Find the point of a batch with the largest signed distance on the left of the start->finish line, with the
+ * widest kernel the processor supports
+ * the cross product is used as the distance, since it is proportional to it and needs no division or sqrt
+ *
+ * @tparam Stride the distance between the coordinates of two consecutive points
+ * @param xs x coordinates of the points
+ * @param ys y coordinates of the points
+ * @param count number of points, must be positive
+ * @param start start point of the line
+ * @param finish end point of the line
+ * @param max_cross output, the cross product of the farthest point, can be nullptr
+ * @return size_t the index of the point with the largest signed distance, the lexicographically smallest one on ties
+ */
+template <size_t Stride>
+size_t farthest_strided_point(const double *xs, const double *ys, size_t count, Point start, Point finish, double *max_cross)
+{
+    double best;
+    size_t best_index;
+#if defined(KERNELS_AVX2)
+    if (kernels_use_avx2())
+    {
+        best_index = farthest_strided_point_avx2<Stride>(xs, ys, count, start, finish, best);
+    }
+    else
+#endif
+    {
+        best_index = farthest_strided_point_baseline<Stride>(xs, ys, count, start, finish, best);
+    }
+
+    if (max_cross != nullptr)
+    {
+        *max_cross = best;
+    }
+    return best_index;
+}
+
+/**
+ * @brief Classify a batch of points against the start->finish line
+ *
+ * @param xs x coordinates of the points
+ * @param ys y coordinates of the points
+ * @param count number of points
+ * @param start start point of the line
+ * @param finish end point of the line
+ * @param sides output, 1 for points on the left (counter-clockwise side) of the line, -1 for points on the right, 0 for points on it
+ */
+void classify_points(const double *xs, const double *ys, size_t count, Point start, Point finish, int8_t *sides)
+{
+    classify_strided_points<1>(xs, ys, count, start, finish, sides);
+}
+
+/**
+ * @brief Classify a batch of points stored as an array of Points against the start->finish line
+ *
+ * @param points the points
+ * @param count number of points
+ * @param start start point of the line
+ * @param finish end point of the line
+ * @param sides output, 1 for points on the left (counter-clockwise side) of the line, -1 for points on the right, 0 for points on it
+ */
+void classify_points(const Point *points, size_t count, Point start, Point finish, int8_t *sides)
+{
+    const double *coordinates = point_coordinates(points);
+    classify_strided_points<2>(coordinates, coordinates + 1, count, start, finish, sides);
+}
+
+/**
+ * @brief Find the point of a batch with the largest signed distance on the left of the start->finish line
+ *
+ * @param xs x coordinates of the points
+ * @param ys y coordinates of the points
+ * @param count number of points, must be positive
+ * @param start start point of the line
+ * @param finish end point of the line
+ * @param max_cross output, the cross product of the farthest point, can be nullptr
+ * @return size_t the index of the point with the largest signed distance, the lexicographically smallest one on ties
+ */
+size_t farthest_point(const double *xs, const double *ys, size_t count, Point start, Point finish, double *max_cross = nullptr)
+{
+    return farthest_strided_point<1>(xs, ys, count, start, finish, max_cross);
+}
+
+/**
+ * @brief Find the point of a batch stored as an array of Points with the largest signed distance on the left of the
+ * start->finish line
+ *
+ * @param points the points
+ * @param count number of points, must be positive
+ * @param start start point of the line
+ * @param finish end point of the line
+ * @param max_cross output, the cross product of the farthest point, can be nullptr
+ * @return size_t the index of the point with the largest signed distance, the lexicographically smallest one on ties
+ */
+size_t farthest_point(const Point *points, size_t count, Point start, Point finish, double *max_cross = nullptr)
+{
+    const double *coordinates = point_coordinates(points);
+    return farthest_strided_point<2>(coordinates, coordinates + 1, count, start, finish, max_cross);
+}
+
+/**
+ * @brief Call visit(i, side) on every point of an array of Points, with its side of the start->finish line from
+ * classify_points
+ * the sides are computed in blocks on the stack, so no memory is allocated; visit may move the points before the
+ * current one, which are already classified
+ *
+ * @tparam Visit a function from an index and a side
+ * @param points the points
+ * @param count number of points
+ * @param line the line, from its start to its end
+ * @param visit the function
+ */
+template <typename Visit>
+void for_each_side(const Point *points, size_t count, Line line, Visit visit)
+{
+    int8_t sides[KERNEL_BLOCK_SIZE];
+    for (size_t block = 0; block < count; block += KERNEL_BLOCK_SIZE)
+    {
+        size_t block_size = std::min((size_t)KERNEL_BLOCK_SIZE, count - block);
+        classify_points(points + block, block_size, line.get_start(), line.get_end(), sides);
+        for (size_t i = 0; i < block_size; i++)
+        {
+            visit(block + i, sides[i]);
+        }
+    }
+}
+
+/**
+ * @brief Call visit(i, first_side, second_side) on every point of an array of Points, with its sides of two lines from
+ * classify_points
+ *
+ * @tparam Visit a function from an index and two sides
+ * @param points the points
+ * @param count number of points
+ * @param first the first line
+ * @param second the second line
+ * @param visit the function
+ */
+template <typename Visit>
+void for_each_side(const Point *points, size_t count, Line first, Line second, Visit visit)
+{
+    int8_t first_sides[KERNEL_BLOCK_SIZE], second_sides[KERNEL_BLOCK_SIZE];
+    for (size_t block = 0; block < count; block += KERNEL_BLOCK_SIZE)
+    {
+        size_t block_size = std::min((size_t)KERNEL_BLOCK_SIZE, count - block);
+        classify_points(points + block, block_size, first.get_start(), first.get_end(), first_sides);
+        classify_points(points + block, block_size, second.get_start(), second.get_end(), second_sides);
+        for (size_t i = 0; i < block_size; i++)
+        {
+            visit(block + i, first_sides[i], second_sides[i]);
+        }
+    }
+}
@@ -11,31 +11,67 @@
 #include "bmp.hpp"
 #include "visualizer.hpp"
 #include "convex_hull.hpp"
+#include "point_file.hpp"
+#include "streaming_hull.hpp"
 
 #define DIM 512
 #define DATA_COUNT 20
 
 /**
  * @brief main function to run the program that finds the convex hull of a randomly generated set of points
+ * when a point file is given, its convex hull is printed instead, reading the file through a memory mapping; with --stream, the
+ * file, or the standard input, is read in chunks with bounded memory instead
  *
+ * @param argc
+ * @param argv the name of a point file, or --stream followed by the name of a point file or "-", optional
  * @return int
  */
-int main()
+int main(int argc, char **argv)
 {
+    if (argc > 1 && std::string(argv[1]) == "--stream")
+    {
+        StreamingHullResult result = streaming_convex_hull(argc > 2 ? argv[2] : "-");
+        if (!result.complete)
+        {
+            cerr << "Could not read the whole input, the hull only covers the first " << result.points << " points" << endl;
+        }
+        cout << "Convex hull points of " << result.points << " points:" << endl;
+        for (Point point : result.hull)
+        {
+            cout << point << endl;
+        }
+        cout << result.points_per_second() << " points per second, in " << result.chunks << " chunks" << endl;
+        return result.complete ? 0 : 1;
+    }
+    if (argc > 1)
+    {
+        MappedPointFile file;
+        if (!file.open(argv[1]))
+        {
+            cerr << "Could not read the point file " << argv[1] << endl;
+            return 1;
+        }
+        std::vector<Point> file_hull = convex_hull(file);
+        cout << "Convex hull points of " << file.size() << " points:" << endl;
+        for (Point point : file_hull)
+        {
+            cout << point << endl;
+        }
+        return 0;
+    }
+
     // generate random data and save to a bmp file
-    double **image_array = initialize_image_array(DIM, DIM);
-    double **image_array2 = initialize_image_array(DIM, DIM);
+    Framebuffer image(DIM, DIM);
     std::vector<Point> data = generate_random_data_points(DATA_COUNT);
     cout << "Data points:" << endl;
     for (vector<Point>::iterator it = data.begin(); it != data.end(); it++)
     {
         Point point = (Point)*it;
         cout << point << endl;
-        image_array = add_point_to_image_array(image_array, DIM, DIM, point);
+        add_point_to_framebuffer(image, point);
     }
-    image_array2 = image_array;
-    std::string hex_image = create_bitmap_hex_from_image_array(image_array, DIM, DIM);
-    create_bmp_file_from_hex(hex_image, (char *)"data.bmp");
+    Framebuffer image2 = image;
+    create_bmp_file_from_framebuffer(image, "data.bmp");
 
     // run gift Quickhull algorithm on the data
     std::vector<Point> convex_hull = quick_hull(data);
@@ -45,14 +81,11 @@ int main()
         Point point = (Point)*it;
         cout << point << endl;
     }
-    std::vector<Line> convex_hull_lines_q = get_convex_hull_lines(convex_hull);
-    for (vector<Line>::iterator it = convex_hull_lines_q.begin(); it != convex_hull_lines_q.end(); it++)
+    for (Line line : hull_edges(convex_hull))
     {
-        Line line = (Line)*it;
-        image_array = add_line_to_image_array(image_array, DIM, DIM, line);
+        add_line_to_framebuffer(image, line);
     }
-    hex_image = create_bitmap_hex_from_image_array(image_array, DIM, DIM);
-    create_bmp_file_from_hex(hex_image, (char *)"convex_hull_quickhull.bmp");
+    create_bmp_file_from_framebuffer(image, "convex_hull_quickhull.bmp");
 
     // run gift Gift-wrapping algorithm on the data
     std::vector<Point> convex_hull_2 = gift_wrapping(data);
@@ -62,14 +95,11 @@ int main()
         Point point = (Point)*it;
         cout << point << endl;
     }
-    std::vector<Line> convex_hull_lines_g = get_convex_hull_lines(convex_hull_2);
-    for (vector<Line>::iterator it = convex_hull_lines_g.begin(); it != convex_hull_lines_g.end(); it++)
+    for (Line line : hull_edges(convex_hull_2))
     {
-        Line line = (Line)*it;
-        image_array2 = add_line_to_image_array(image_array2, DIM, DIM, line);
+        add_line_to_framebuffer(image2, line);
     }
-    hex_image = create_bitmap_hex_from_image_array(image_array2, DIM, DIM);
-    create_bmp_file_from_hex(hex_image, (char *)"convex_hull_giftwrapping.bmp");
+    create_bmp_file_from_framebuffer(image2, "convex_hull_giftwrapping.bmp");
 
     return 0;
 }
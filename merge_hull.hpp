@@ -0,0 +1,149 @@
+/**
+ * @file merge_hull.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief Merging convex hulls found separately, such as the hulls of the shards of a point set, in linear time
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <span>
+#include <vector>
+#include "geometry.hpp"
+#include "convex_hull.hpp"
+#include "batch_hull.hpp"
+#include "thread_pool.hpp"
+
+#define MERGE_GRAIN_SIZE 16
+
+/**
+ * @brief Write the vertices of a hull in lexicographic order, in O(h)
+ * from its lowest leftmost vertex, a hull runs up to its highest rightmost vertex along its lower chain and back along its
+ * upper chain, so the vertices are sorted by merging the lower chain with the reversed upper chain
+ *
+ * @tparam T the type of the coordinates
+ * @param hull the vertices of the hull, in counter-clockwise order starting from the lowest leftmost one, as returned by any engine
+ * @param sorted output, with room for the h vertices
+ * @return BasicPoint<T>* the end of the sorted vertices
+ */
+template <typename T>
+BasicPoint<T> *sorted_hull_vertices(std::span<const BasicPoint<T>> hull, BasicPoint<T> *sorted)
+{
+    if (hull.empty())
+    {
+        return sorted;
+    }
+    auto upper_begin = max_element(hull.begin(), hull.end()) + 1;
+    return merge(hull.begin(), upper_begin, std::make_reverse_iterator(hull.end()), std::make_reverse_iterator(upper_begin), sorted);
+}
+
+/**
+ * @brief A function to find the convex hull of two convex hulls, in O(h1 + h2)
+ * the vertices of both hulls are merged in lexicographic order without sorting them, and monotone chain finds the hull
+ * of the merged vertices in one pass, popping the vertices between the bridges joining the two hulls; unlike looking for
+ * the bridges directly, this also works when the hulls overlap, or when one is inside the other
+ *
+ * @tparam T the type of the coordinates, the turns are exact for integer coordinates
+ * @param a the vertices of the first hull, in counter-clockwise order starting from the lowest leftmost one, as returned by any engine
+ * @param b the vertices of the second hull, in the same order
+ * @return vector<BasicPoint<T>> the convex hull of both, in counter-clockwise order starting from the lowest leftmost point
+ */
+template <typename T>
+vector<BasicPoint<T>> merge_hulls(std::span<const BasicPoint<T>> a, std::span<const BasicPoint<T>> b)
+{
+    size_t count = a.size() + b.size();
+    vector<BasicPoint<T>> vertices(count), sorted(count);
+    BasicPoint<T> *a_end = sorted_hull_vertices(a, vertices.data());
+    BasicPoint<T> *b_end = sorted_hull_vertices(b, a_end);
+    merge(vertices.data(), a_end, a_end, b_end, sorted.data());
+    count = (size_t)(unique(sorted.begin(), sorted.end()) - sorted.begin());
+
+    // the vertices are not needed anymore, so their memory holds the hull
+    vertices.resize(2 * count);
+    vertices.resize(build_monotone_chain(sorted.data(), count, vertices.data()));
+    return vertices;
+}
+
+/**
+ * @brief A function to find the convex hull of two convex hulls, in O(h1 + h2)
+ *
+ * @tparam T the type of the coordinates
+ * @param a the vertices of the first hull, in counter-clockwise order starting from the lowest leftmost one, as returned by any engine
+ * @param b the vertices of the second hull, in the same order
+ * @return vector<BasicPoint<T>> the convex hull of both, in counter-clockwise order starting from the lowest leftmost point
+ */
+template <typename T>
+vector<BasicPoint<T>> merge_hulls(const vector<BasicPoint<T>> &a, const vector<BasicPoint<T>> &b)
+{
+    return merge_hulls(std::span<const BasicPoint<T>>(a), std::span<const BasicPoint<T>>(b));
+}
+
+/**
+ * @brief A function to find the convex hull of many convex hulls, merging them in pairs as a tree, in parallel
+ * every level merges its hulls two by two in parallel and halves their number, so k hulls are merged in log(k) levels,
+ * each in time linear in the total size of the hulls
+ *
+ * @param hulls the hulls, each in counter-clockwise order starting from its lowest leftmost vertex
+ * @param pool the pool merging the pairs
+ * @param grain_size the minimum number of pairs merged by a task
+ * @return vector<Point> the convex hull of all the hulls, in counter-clockwise order starting from the lowest leftmost point
+ */
+vector<Point> merge_hulls(vector<std::span<const Point>> hulls, ThreadPool &pool = default_thread_pool(), size_t grain_size = MERGE_GRAIN_SIZE)
+{
+    vector<vector<Point>> level;
+    while (hulls.size() > 1)
+    {
+        size_t pair_count = hulls.size() / 2;
+        vector<vector<Point>> next_level(hulls.size() - pair_count);
+        parallel_chunks(pool, 0, pair_count, parallel_chunk_count(pool, pair_count, grain_size), [&](size_t, size_t chunk_begin, size_t chunk_end)
+                        {
+            for (size_t i = chunk_begin; i < chunk_end; i++)
+            {
+                next_level[i] = merge_hulls(hulls[2 * i], hulls[2 * i + 1]);
+            } });
+        // with an odd number of hulls, the last one moves up a level alone
+        if (hulls.size() % 2 == 1)
+        {
+            next_level.back().assign(hulls.back().begin(), hulls.back().end());
+        }
+        level = std::move(next_level);
+        hulls.assign(level.begin(), level.end());
+    }
+    return hulls.empty() ? vector<Point>() : vector<Point>(hulls[0].begin(), hulls[0].end());
+}
+
+/**
+ * @brief A function to find the convex hull of many convex hulls, merging them in pairs as a tree, in parallel
+ *
+ * @param hulls the hulls, each in counter-clockwise order starting from its lowest leftmost vertex
+ * @param pool the pool merging the pairs
+ * @param grain_size the minimum number of pairs merged by a task
+ * @return vector<Point> the convex hull of all the hulls, in counter-clockwise order starting from the lowest leftmost point
+ */
+vector<Point> merge_hulls(const vector<vector<Point>> &hulls, ThreadPool &pool = default_thread_pool(), size_t grain_size = MERGE_GRAIN_SIZE)
+{
+    return merge_hulls(vector<std::span<const Point>>(hulls.begin(), hulls.end()), pool, grain_size);
+}
+
+/**
+ * @brief A function to find the convex hull of a batch of hulls, merging them in pairs as a tree, in parallel
+ *
+ * @param hulls the hulls, such as the ones found by batch_convex_hull
+ * @param pool the pool merging the pairs
+ * @param grain_size the minimum number of pairs merged by a task
+ * @return vector<Point> the convex hull of all the hulls, in counter-clockwise order starting from the lowest leftmost point
+ */
+vector<Point> merge_hulls(const HullBatch &hulls, ThreadPool &pool = default_thread_pool(), size_t grain_size = MERGE_GRAIN_SIZE)
+{
+    vector<std::span<const Point>> spans(hulls.size());
+    for (size_t i = 0; i < hulls.size(); i++)
+    {
+        spans[i] = hulls[i];
+    }
+    return merge_hulls(std::move(spans), pool, grain_size);
+}
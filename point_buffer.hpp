@@ -0,0 +1,279 @@
+/**
+ * @file point_buffer.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief A structure-of-arrays container for large sets of points
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "geometry.hpp"
+
+#define POINT_BUFFER_ALIGNMENT 64
+
+/**
+ * @brief A class to store a set of points as two separate, aligned arrays of x and y coordinates
+ * keeping the coordinates apart lets the batch kernels load a full SIMD register of x's or y's at once
+ */
+class PointBuffer
+{
+private:
+    /**
+     * @brief The coordinate arrays, both aligned to POINT_BUFFER_ALIGNMENT bytes
+     */
+    double *xs, *ys;
+
+    /**
+     * @brief The number of points stored, and the number of points the arrays can hold
+     */
+    size_t count, capacity;
+
+    /**
+     * @brief Allocate an aligned array of doubles
+     *
+     * @param length the number of doubles
+     * @return double*
+     */
+    static double *allocate(size_t length)
+    {
+        if (length == 0)
+        {
+            return nullptr;
+        }
+        return static_cast<double *>(::operator new(length * sizeof(double), std::align_val_t(POINT_BUFFER_ALIGNMENT)));
+    }
+
+    /**
+     * @brief Free an array allocated with allocate
+     *
+     * @param array
+     */
+    static void deallocate(double *array)
+    {
+        if (array != nullptr)
+        {
+            ::operator delete(array, std::align_val_t(POINT_BUFFER_ALIGNMENT));
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new empty Point Buffer object
+     */
+    PointBuffer() : xs(nullptr), ys(nullptr), count(0), capacity(0)
+    {
+    }
+
+    /**
+     * @brief Construct a new Point Buffer object holding size points at (0, 0)
+     *
+     * @param size the number of points
+     */
+    explicit PointBuffer(size_t size) : xs(allocate(size)), ys(allocate(size)), count(size), capacity(size)
+    {
+        std::fill(xs, xs + size, 0.0);
+        std::fill(ys, ys + size, 0.0);
+    }
+
+    /**
+     * @brief Construct a new Point Buffer object from a vector of points
+     *
+     * @param points
+     */
+    explicit PointBuffer(const std::vector<Point> &points) : PointBuffer(points.size())
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            xs[i] = points[i].get_x();
+            ys[i] = points[i].get_y();
+        }
+    }
+
+    PointBuffer(const PointBuffer &other) : xs(allocate(other.count)), ys(allocate(other.count)), count(other.count), capacity(other.count)
+    {
+        std::copy(other.xs, other.xs + count, xs);
+        std::copy(other.ys, other.ys + count, ys);
+    }
+
+    PointBuffer(PointBuffer &&other) noexcept : xs(other.xs), ys(other.ys), count(other.count), capacity(other.capacity)
+    {
+        other.xs = other.ys = nullptr;
+        other.count = other.capacity = 0;
+    }
+
+    PointBuffer &operator=(PointBuffer other) noexcept
+    {
+        std::swap(xs, other.xs);
+        std::swap(ys, other.ys);
+        std::swap(count, other.count);
+        std::swap(capacity, other.capacity);
+        return *this;
+    }
+
+    ~PointBuffer()
+    {
+        deallocate(xs);
+        deallocate(ys);
+    }
+
+    /**
+     * @brief Get the number of points
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * @brief Check if the buffer holds no points
+     *
+     * @return true if there are no points
+     * @return false otherwise
+     */
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * @brief Get the array of x coordinates
+     *
+     * @return double*
+     */
+    double *x()
+    {
+        return xs;
+    }
+
+    const double *x() const
+    {
+        return xs;
+    }
+
+    /**
+     * @brief Get the array of y coordinates
+     *
+     * @return double*
+     */
+    double *y()
+    {
+        return ys;
+    }
+
+    const double *y() const
+    {
+        return ys;
+    }
+
+    /**
+     * @brief Get the point at the given index
+     *
+     * @param index
+     * @return Point
+     */
+    Point get(size_t index) const
+    {
+        return Point(xs[index], ys[index]);
+    }
+
+    /**
+     * @brief Set the point at the given index
+     *
+     * @param index
+     * @param p
+     */
+    void set(size_t index, Point p)
+    {
+        xs[index] = p.get_x();
+        ys[index] = p.get_y();
+    }
+
+    /**
+     * @brief Swap the points at two indices
+     *
+     * @param first
+     * @param second
+     */
+    void swap_points(size_t first, size_t second)
+    {
+        std::swap(xs[first], xs[second]);
+        std::swap(ys[first], ys[second]);
+    }
+
+    /**
+     * @brief Make sure the arrays can hold at least new_capacity points
+     *
+     * @param new_capacity
+     */
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity <= capacity)
+        {
+            return;
+        }
+        double *new_xs = allocate(new_capacity), *new_ys = allocate(new_capacity);
+        std::copy(xs, xs + count, new_xs);
+        std::copy(ys, ys + count, new_ys);
+        deallocate(xs);
+        deallocate(ys);
+        xs = new_xs;
+        ys = new_ys;
+        capacity = new_capacity;
+    }
+
+    /**
+     * @brief Change the number of points, new points are set to (0, 0)
+     * shrinking never reallocates
+     *
+     * @param new_size
+     */
+    void resize(size_t new_size)
+    {
+        if (new_size > count)
+        {
+            reserve(new_size);
+            std::fill(xs + count, xs + new_size, 0.0);
+            std::fill(ys + count, ys + new_size, 0.0);
+        }
+        count = new_size;
+    }
+
+    /**
+     * @brief Add a point at the end of the buffer
+     *
+     * @param p
+     */
+    void push_back(Point p)
+    {
+        if (count == capacity)
+        {
+            reserve(capacity == 0 ? 16 : 2 * capacity);
+        }
+        set(count++, p);
+    }
+
+    /**
+     * @brief Copy the points into a vector of points
+     *
+     * @return std::vector<Point>
+     */
+    std::vector<Point> to_vector() const
+    {
+        std::vector<Point> points;
+        points.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            points.push_back(get(i));
+        }
+        return points;
+    }
+};
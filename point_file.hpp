@@ -0,0 +1,347 @@
+/**
+ * @file point_file.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief A binary point file format, and a loader mapping it into memory so that large files are hulled without being read into a vector
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "geometry.hpp"
+#include "point_buffer.hpp"
+#include "convex_hull.hpp"
+
+/**
+ * @brief A point file is a POINT_FILE_HEADER_SIZE byte header followed by the coordinates as native doubles
+ * the header holds the magic bytes, the version, the layout and the number of points; the rest of it is zero
+ */
+#define POINT_FILE_MAGIC "CHPOINTS"
+#define POINT_FILE_MAGIC_SIZE 8
+#define POINT_FILE_VERSION 1
+#define POINT_FILE_HEADER_SIZE 64
+
+static_assert(sizeof(Point) == 2 * sizeof(double) && std::is_standard_layout_v<Point>, "an array of structures file is read as an array of Point");
+
+/**
+ * @brief How the coordinates are laid out after the header
+ */
+enum class PointLayout : uint32_t
+{
+    /**
+     * @brief x0, y0, x1, y1, ...
+     */
+    ARRAY_OF_STRUCTURES = 0,
+
+    /**
+     * @brief x0, x1, ..., then y0, y1, ...
+     */
+    STRUCTURE_OF_ARRAYS = 1
+};
+
+/**
+ * @brief The header of a point file, as it is stored at the start of the file
+ */
+struct PointFileHeader
+{
+    char magic[POINT_FILE_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t layout;
+    uint64_t count;
+    uint8_t reserved[POINT_FILE_HEADER_SIZE - POINT_FILE_MAGIC_SIZE - 2 * sizeof(uint32_t) - sizeof(uint64_t)];
+};
+
+static_assert(sizeof(PointFileHeader) == POINT_FILE_HEADER_SIZE, "the header must not be padded");
+
+/**
+ * @brief Build the header of a point file
+ *
+ * @param count the number of points
+ * @param layout
+ * @return PointFileHeader
+ */
+PointFileHeader make_point_file_header(uint64_t count, PointLayout layout)
+{
+    PointFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, POINT_FILE_MAGIC, POINT_FILE_MAGIC_SIZE);
+    header.version = POINT_FILE_VERSION;
+    header.layout = (uint32_t)layout;
+    header.count = count;
+    return header;
+}
+
+/**
+ * @brief Write a set of points to a point file
+ *
+ * @param filename
+ * @param points
+ * @param layout
+ * @return true if the file was written
+ * @return false otherwise
+ */
+bool write_point_file(const char *filename, std::span<const Point> points, PointLayout layout)
+{
+    FILE *file = fopen(filename, "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    PointFileHeader header = make_point_file_header(points.size(), layout);
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    if (layout == PointLayout::ARRAY_OF_STRUCTURES)
+    {
+        written = written && fwrite(points.data(), sizeof(Point), points.size(), file) == points.size();
+    }
+    else
+    {
+        std::vector<double> coordinates(points.size());
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            coordinates[i] = points[i].get_x();
+        }
+        written = written && fwrite(coordinates.data(), sizeof(double), points.size(), file) == points.size();
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            coordinates[i] = points[i].get_y();
+        }
+        written = written && fwrite(coordinates.data(), sizeof(double), points.size(), file) == points.size();
+    }
+    return fclose(file) == 0 && written;
+}
+
+/**
+ * @brief Write a structure-of-arrays buffer to a point file, in the structure of arrays layout
+ *
+ * @param filename
+ * @param points
+ * @return true if the file was written
+ * @return false otherwise
+ */
+bool write_point_file(const char *filename, const PointBuffer &points)
+{
+    FILE *file = fopen(filename, "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    PointFileHeader header = make_point_file_header(points.size(), PointLayout::STRUCTURE_OF_ARRAYS);
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    written = written && fwrite(points.x(), sizeof(double), points.size(), file) == points.size();
+    written = written && fwrite(points.y(), sizeof(double), points.size(), file) == points.size();
+    return fclose(file) == 0 && written;
+}
+
+/**
+ * @brief A read-only point file mapped into memory
+ * the pages are only read from the disk when they are touched, and the kernel is told they will be read sequentially, so it
+ * reads ahead and drops them behind; a file larger than the memory can be hulled in one pass
+ */
+class MappedPointFile
+{
+private:
+    void *mapping;
+    size_t mapping_size;
+    PointFileHeader header;
+
+    /**
+     * @brief Get the first coordinate after the header
+     *
+     * @return const double*
+     */
+    const double *coordinates() const
+    {
+        return reinterpret_cast<const double *>(static_cast<const uint8_t *>(mapping) + POINT_FILE_HEADER_SIZE);
+    }
+
+public:
+    MappedPointFile() : mapping(nullptr), mapping_size(0)
+    {
+        std::memset(&header, 0, sizeof(header));
+    }
+
+    MappedPointFile(const MappedPointFile &other) = delete;
+    MappedPointFile &operator=(const MappedPointFile &other) = delete;
+
+    ~MappedPointFile()
+    {
+        close();
+    }
+
+    /**
+     * @brief Map a point file, closing the one mapped before
+     * the header is checked against the size of the file before anything is exposed
+     *
+     * @param filename
+     * @return true if the file is a valid point file and was mapped
+     * @return false otherwise
+     */
+    bool open(const char *filename)
+    {
+        close();
+        int descriptor = ::open(filename, O_RDONLY);
+        if (descriptor < 0)
+        {
+            return false;
+        }
+        struct stat status;
+        if (fstat(descriptor, &status) != 0 || (uint64_t)status.st_size < POINT_FILE_HEADER_SIZE)
+        {
+            ::close(descriptor);
+            return false;
+        }
+
+        size_t size = (size_t)status.st_size;
+        void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        // the mapping keeps the file open by itself
+        ::close(descriptor);
+        if (mapped == MAP_FAILED)
+        {
+            return false;
+        }
+
+        PointFileHeader mapped_header;
+        std::memcpy(&mapped_header, mapped, sizeof(mapped_header));
+        bool valid = std::memcmp(mapped_header.magic, POINT_FILE_MAGIC, POINT_FILE_MAGIC_SIZE) == 0 &&
+                     mapped_header.version == POINT_FILE_VERSION &&
+                     mapped_header.layout <= (uint32_t)PointLayout::STRUCTURE_OF_ARRAYS &&
+                     mapped_header.count <= (size - POINT_FILE_HEADER_SIZE) / sizeof(Point) &&
+                     mapped_header.count * sizeof(Point) == size - POINT_FILE_HEADER_SIZE;
+        if (!valid)
+        {
+            munmap(mapped, size);
+            return false;
+        }
+
+        madvise(mapped, size, MADV_SEQUENTIAL);
+        mapping = mapped;
+        mapping_size = size;
+        header = mapped_header;
+        return true;
+    }
+
+    /**
+     * @brief Unmap the file, if one is mapped
+     */
+    void close()
+    {
+        if (mapping != nullptr)
+        {
+            munmap(mapping, mapping_size);
+        }
+        mapping = nullptr;
+        mapping_size = 0;
+        std::memset(&header, 0, sizeof(header));
+    }
+
+    /**
+     * @brief Check if a file is mapped
+     *
+     * @return true if a file is mapped
+     * @return false otherwise
+     */
+    bool is_open() const
+    {
+        return mapping != nullptr;
+    }
+
+    /**
+     * @brief Get the number of points
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return (size_t)header.count;
+    }
+
+    PointLayout layout() const
+    {
+        return (PointLayout)header.layout;
+    }
+
+    /**
+     * @brief Get the points of an array of structures file, without copying them
+     *
+     * @return std::span<const Point> the points, empty for the other layout
+     */
+    std::span<const Point> points() const
+    {
+        if (!is_open() || layout() != PointLayout::ARRAY_OF_STRUCTURES)
+        {
+            return std::span<const Point>();
+        }
+        return std::span<const Point>(reinterpret_cast<const Point *>(coordinates()), size());
+    }
+
+    /**
+     * @brief Get the x coordinates of a structure of arrays file, without copying them
+     *
+     * @return std::span<const double> the x coordinates, empty for the other layout
+     */
+    std::span<const double> x() const
+    {
+        if (!is_open() || layout() != PointLayout::STRUCTURE_OF_ARRAYS)
+        {
+            return std::span<const double>();
+        }
+        return std::span<const double>(coordinates(), size());
+    }
+
+    /**
+     * @brief Get the y coordinates of a structure of arrays file, without copying them
+     *
+     * @return std::span<const double> the y coordinates, empty for the other layout
+     */
+    std::span<const double> y() const
+    {
+        if (!is_open() || layout() != PointLayout::STRUCTURE_OF_ARRAYS)
+        {
+            return std::span<const double>();
+        }
+        return std::span<const double>(coordinates() + size(), size());
+    }
+
+    /**
+     * @brief Get the point at the given index, in either layout
+     *
+     * @param index
+     * @return Point
+     */
+    Point get(size_t index) const
+    {
+        if (layout() == PointLayout::ARRAY_OF_STRUCTURES)
+        {
+            return Point(coordinates()[2 * index], coordinates()[2 * index + 1]);
+        }
+        return Point(coordinates()[index], coordinates()[size() + index]);
+    }
+};
+
+/**
+ * @brief A function to find the convex hull of a mapped point file, streaming over the mapping without copying it
+ *
+ * @param file
+ * @param options
+ * @return vector<Point> a vector of points that form the convex hull, empty if no file is mapped
+ */
+vector<Point> convex_hull(const MappedPointFile &file, HullOptions options = HullOptions())
+{
+    if (file.layout() == PointLayout::ARRAY_OF_STRUCTURES)
+    {
+        return convex_hull(file.points(), options);
+    }
+    return convex_hull(file.x(), file.y(), options);
+}
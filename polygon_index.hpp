@@ -0,0 +1,295 @@
+/**
+ * @file polygon_index.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief An index over a convex polygon answering point containment queries in O(log(h)), one by one or in batches
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "geometry.hpp"
+#include "kernels.hpp"
+#include "point_buffer.hpp"
+#include "thread_pool.hpp"
+
+#define LOCATE_GRAIN_SIZE 65536
+
+/**
+ * @brief Where a point is with respect to a convex polygon
+ */
+enum class PointLocation : uint8_t
+{
+    OUTSIDE,
+    BOUNDARY,
+    INSIDE
+};
+
+/**
+ * @brief An index over a convex polygon, such as a hull returned by any engine, locating points in O(log(h))
+ * the polygon is split into a fan of triangles around its first vertex; a binary search over the rays of the fan finds
+ * the wedge a point is in, and a single turn against the edge closing the wedge tells if the point is inside. Every turn
+ * is exact, so points on the boundary are always found
+ */
+class ConvexPolygonIndex
+{
+private:
+    /**
+     * @brief The vertices, in counter-clockwise order
+     */
+    std::vector<Point> vertices;
+
+    /**
+     * @brief The coordinates of the vertices, the rays of the fan from the first vertex and the edges, as structure of
+     * arrays for the batch queries; the differences are the ones orient2d computes, so both round the same way
+     */
+    std::vector<double> xs, ys, ray_xs, ray_ys, edge_xs, edge_ys;
+
+    /**
+     * @brief Locate a point with respect to the degenerate polygons: nothing, a point or a segment
+     *
+     * @param p
+     * @return PointLocation
+     */
+    PointLocation locate_degenerate(Point p) const
+    {
+        if (vertices.size() == 1)
+        {
+            return p == vertices[0] ? PointLocation::BOUNDARY : PointLocation::OUTSIDE;
+        }
+        if (vertices.size() == 2 && orient2d(vertices[0], vertices[1], p) == 0 &&
+            min(vertices[0].get_x(), vertices[1].get_x()) <= p.get_x() && p.get_x() <= max(vertices[0].get_x(), vertices[1].get_x()) &&
+            min(vertices[0].get_y(), vertices[1].get_y()) <= p.get_y() && p.get_y() <= max(vertices[0].get_y(), vertices[1].get_y()))
+        {
+            return PointLocation::BOUNDARY;
+        }
+        return PointLocation::OUTSIDE;
+    }
+
+#if defined(KERNELS_AVX2)
+    /**
+     * @brief The turn of four points against the vector (dx, dy) from an origin, with (px, py) the points minus the origin
+     *
+     * @param dx
+     * @param dy
+     * @param px
+     * @param py
+     * @param positive output, the lanes where it is certainly counter-clockwise
+     * @param negative output, the lanes where it is certainly clockwise
+     * @param uncertain the other lanes are added to it
+     */
+    AVX2_TARGET static void turn_four(const __m256d &dx, const __m256d &dy, const __m256d &px, const __m256d &py, __m256d &positive, __m256d &negative, __m256d &uncertain)
+    {
+        __m256d error_bound = _mm256_set1_pd(ORIENT2D_ERROR_BOUND), sign_mask = _mm256_set1_pd(-0.0);
+        __m256d left = _mm256_mul_pd(dx, py), right = _mm256_mul_pd(dy, px);
+        __m256d cross = _mm256_sub_pd(left, right);
+        __m256d bound = _mm256_mul_pd(error_bound, _mm256_add_pd(_mm256_andnot_pd(sign_mask, left), _mm256_andnot_pd(sign_mask, right)));
+        positive = _mm256_cmp_pd(cross, bound, _CMP_GT_OQ);
+        negative = _mm256_cmp_pd(_mm256_xor_pd(cross, sign_mask), bound, _CMP_GT_OQ);
+        uncertain = _mm256_or_pd(uncertain, _mm256_andnot_pd(_mm256_or_pd(positive, negative), _mm256_castsi256_pd(_mm256_set1_epi64x(-1))));
+    }
+
+    /**
+     * @brief Locate four points at once with a branch-free binary search, gathering the rays and edges
+     * every lane of the search takes the same number of steps; a lane whose turns are all certain is strictly inside or
+     * outside, and the others are located again, exactly, by locate
+     *
+     * @param xs_to_locate x coordinates of the four points
+     * @param ys_to_locate y coordinates of the four points
+     * @param locations output, the location of the four points
+     */
+    AVX2_TARGET void locate_four(const double *xs_to_locate, const double *ys_to_locate, PointLocation *locations) const
+    {
+        __m256d x = _mm256_loadu_pd(xs_to_locate), y = _mm256_loadu_pd(ys_to_locate);
+        __m256d qx = _mm256_sub_pd(x, _mm256_set1_pd(xs[0])), qy = _mm256_sub_pd(y, _mm256_set1_pd(ys[0]));
+
+        __m256d positive, negative, uncertain = _mm256_setzero_pd();
+
+        size_t h = vertices.size();
+        turn_four(_mm256_set1_pd(ray_xs[1]), _mm256_set1_pd(ray_ys[1]), qx, qy, positive, negative, uncertain);
+        __m256d outside = negative;
+        turn_four(_mm256_set1_pd(ray_xs[h - 1]), _mm256_set1_pd(ray_ys[h - 1]), qx, qy, positive, negative, uncertain);
+        outside = _mm256_or_pd(outside, positive);
+
+        // the last ray in [1, h - 2] that the point is not clockwise of
+        __m256i base = _mm256_set1_epi64x(1);
+        for (size_t n = h - 2; n > 1; n -= n / 2)
+        {
+            __m256i middle = _mm256_add_epi64(base, _mm256_set1_epi64x((long long)(n / 2)));
+            turn_four(_mm256_i64gather_pd(ray_xs.data(), middle, 8), _mm256_i64gather_pd(ray_ys.data(), middle, 8), qx, qy, positive, negative, uncertain);
+            base = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(base), _mm256_castsi256_pd(middle), positive));
+        }
+
+        __m256d px = _mm256_sub_pd(x, _mm256_i64gather_pd(xs.data(), base, 8));
+        __m256d py = _mm256_sub_pd(y, _mm256_i64gather_pd(ys.data(), base, 8));
+        turn_four(_mm256_i64gather_pd(edge_xs.data(), base, 8), _mm256_i64gather_pd(edge_ys.data(), base, 8), px, py, positive, negative, uncertain);
+
+        // outside the first or last ray is always right, an uncertain turn in the search may have picked the wrong wedge
+        int outside_lanes = _mm256_movemask_pd(outside), uncertain_lanes = _mm256_movemask_pd(uncertain);
+        int inside_lanes = _mm256_movemask_pd(positive);
+        for (int k = 0; k < 4; k++)
+        {
+            if ((outside_lanes >> k) & 1)
+            {
+                locations[k] = PointLocation::OUTSIDE;
+            }
+            else if ((uncertain_lanes >> k) & 1)
+            {
+                locations[k] = locate(Point(xs_to_locate[k], ys_to_locate[k]));
+            }
+            else
+            {
+                locations[k] = (inside_lanes >> k) & 1 ? PointLocation::INSIDE : PointLocation::OUTSIDE;
+            }
+        }
+    }
+#endif
+
+public:
+    /**
+     * @brief Construct a new Convex Polygon Index object
+     *
+     * @param polygon the vertices of a convex polygon in counter-clockwise order without collinear vertices, as returned by
+     * any engine
+     */
+    explicit ConvexPolygonIndex(std::span<const Point> polygon) : vertices(polygon.begin(), polygon.end())
+    {
+        size_t h = vertices.size();
+        xs.resize(h);
+        ys.resize(h);
+        ray_xs.resize(h);
+        ray_ys.resize(h);
+        edge_xs.resize(h);
+        edge_ys.resize(h);
+        for (size_t i = 0; i < h; i++)
+        {
+            xs[i] = vertices[i].get_x();
+            ys[i] = vertices[i].get_y();
+            ray_xs[i] = vertices[i].get_x() - vertices[0].get_x();
+            ray_ys[i] = vertices[i].get_y() - vertices[0].get_y();
+            edge_xs[i] = vertices[(i + 1) % h].get_x() - vertices[i].get_x();
+            edge_ys[i] = vertices[(i + 1) % h].get_y() - vertices[i].get_y();
+        }
+    }
+
+    /**
+     * @brief Get the number of vertices of the polygon
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return vertices.size();
+    }
+
+    /**
+     * @brief Locate a point with respect to the polygon, in O(log(h))
+     *
+     * @param p
+     * @return PointLocation
+     */
+    PointLocation locate(Point p) const
+    {
+        size_t h = vertices.size();
+        if (h < 3)
+        {
+            return locate_degenerate(p);
+        }
+
+        Point origin = vertices[0];
+        double first = orient2d(origin, vertices[1], p), last = orient2d(origin, vertices[h - 1], p);
+        if (first < 0 || last > 0)
+        {
+            return PointLocation::OUTSIDE;
+        }
+
+        // the last ray in [1, h - 2] that p is not clockwise of, the wedge between it and the next one holds p
+        size_t low = 1, high = h - 2;
+        while (low < high)
+        {
+            size_t middle = (low + high + 1) / 2;
+            if (orient2d(origin, vertices[middle], p) >= 0)
+            {
+                low = middle;
+            }
+            else
+            {
+                high = middle - 1;
+            }
+        }
+
+        double edge = orient2d(vertices[low], vertices[low + 1], p);
+        if (edge < 0)
+        {
+            return PointLocation::OUTSIDE;
+        }
+        // the first and last rays of the fan are edges of the polygon too
+        if (edge == 0 || (low == 1 && first == 0) || (low == h - 2 && last == 0))
+        {
+            return PointLocation::BOUNDARY;
+        }
+        return PointLocation::INSIDE;
+    }
+
+    /**
+     * @brief Check if a point is inside the polygon or on its boundary
+     *
+     * @param p
+     * @return true if the point is not outside the polygon
+     * @return false otherwise
+     */
+    bool contains(Point p) const
+    {
+        return locate(p) != PointLocation::OUTSIDE;
+    }
+
+    /**
+     * @brief Locate a batch of points, four at a time with AVX2 when the processor supports it
+     *
+     * @param xs_to_locate x coordinates of the points
+     * @param ys_to_locate y coordinates of the points
+     * @param count number of points
+     * @param locations output, the location of every point
+     */
+    void locate(const double *xs_to_locate, const double *ys_to_locate, size_t count, PointLocation *locations) const
+    {
+        size_t i = 0;
+#if defined(KERNELS_AVX2)
+        if (vertices.size() >= 3 && kernels_use_avx2())
+        {
+            for (; i + 4 <= count; i += 4)
+            {
+                locate_four(xs_to_locate + i, ys_to_locate + i, locations + i);
+            }
+        }
+#endif
+        for (; i < count; i++)
+        {
+            locations[i] = locate(Point(xs_to_locate[i], ys_to_locate[i]));
+        }
+    }
+
+    /**
+     * @brief Locate a batch of points in parallel
+     *
+     * @param points the points to locate
+     * @param locations output, resized to the number of points
+     * @param pool the pool locating the chunks
+     * @param grain_size the minimum number of points in a chunk
+     */
+    void locate(const PointBuffer &points, std::vector<PointLocation> &locations, ThreadPool &pool = default_thread_pool(), size_t grain_size = LOCATE_GRAIN_SIZE) const
+    {
+        locations.resize(points.size());
+        const double *points_x = points.x(), *points_y = points.y();
+        PointLocation *output = locations.data();
+        parallel_chunks(pool, 0, points.size(), parallel_chunk_count(pool, points.size(), grain_size), [&](size_t, size_t chunk_begin, size_t chunk_end)
+                        { locate(points_x + chunk_begin, points_y + chunk_begin, chunk_end - chunk_begin, output + chunk_begin); });
+    }
+};
@@ -0,0 +1,335 @@
+/**
+ * @file prefilter.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief The Akl-Toussaint heuristic, discarding the points that cannot be on the convex hull before running a hull engine
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <vector>
+#include "geometry.hpp"
+#include "point_buffer.hpp"
+#include "thread_pool.hpp"
+
+#define PREFILTER_GRAIN_SIZE 65536
+#define OCTAGON_SIZE 8
+
+/**
+ * @brief The octagon spanned by the extreme points of a set in the directions of x, y, x + y and x - y
+ * the vertices are kept in counter-clockwise order: min x, min x + y, min y, max x - y, max x, max x + y, max y, min x - y
+ */
+struct Octagon
+{
+    /**
+     * @brief The extreme points, some of them may be the same point
+     */
+    std::array<Point, OCTAGON_SIZE> vertices;
+
+    /**
+     * @brief The edges between distinct consecutive vertices, stored as their start point and direction, and their end
+     * point for the exact test
+     */
+    std::array<double, OCTAGON_SIZE> start_x, start_y, direction_x, direction_y, end_x, end_y;
+    size_t edge_count = 0;
+
+    /**
+     * @brief Build the edges from the vertices, skipping the zero length ones
+     */
+    void build_edges()
+    {
+        edge_count = 0;
+        for (size_t i = 0; i < OCTAGON_SIZE; i++)
+        {
+            Point from = vertices[i], to = vertices[(i + 1) % OCTAGON_SIZE];
+            if (from == to)
+            {
+                continue;
+            }
+            start_x[edge_count] = from.get_x();
+            start_y[edge_count] = from.get_y();
+            direction_x[edge_count] = to.get_x() - from.get_x();
+            direction_y[edge_count] = to.get_y() - from.get_y();
+            end_x[edge_count] = to.get_x();
+            end_y[edge_count] = to.get_y();
+            edge_count++;
+        }
+    }
+
+    /**
+     * @brief Check if a point is strictly inside the octagon, in which case it cannot be on the convex hull
+     * the turns are those of orient2d: the edge directions are the differences it computes, so its error bound applies.
+     * The test is branch-free over the edges so that the loops calling it can be vectorized, and the rare points with a
+     * turn too close to call are tested again exactly, so a point on the boundary, which may be on a hull edge, is kept
+     *
+     * @param x
+     * @param y
+     * @return true if the point is strictly on the left of every edge
+     * @return false otherwise, and always when the octagon is degenerate
+     */
+    bool strictly_contains(double x, double y) const
+    {
+        bool inside = edge_count >= 3, outside = false;
+        for (size_t i = 0; i < edge_count; i++)
+        {
+            double left = direction_x[i] * (y - start_y[i]), right = direction_y[i] * (x - start_x[i]);
+            double cross = left - right, bound = ORIENT2D_ERROR_BOUND * (std::fabs(left) + std::fabs(right));
+            inside &= cross > bound;
+            outside |= -cross > bound;
+        }
+        if (inside || outside || edge_count < 3)
+        {
+            return inside;
+        }
+
+        inside = true;
+        for (size_t i = 0; i < edge_count; i++)
+        {
+            inside = inside && orient2d(Point(start_x[i], start_y[i]), Point(end_x[i], end_y[i]), Point(x, y)) > 0;
+        }
+        return inside;
+    }
+};
+
+/**
+ * @brief Update the extreme points of a set with a new point
+ *
+ * @param extremes the extremes found so far, in the order of Octagon::vertices
+ * @param p the new point
+ */
+void update_octagon_extremes(std::array<Point, OCTAGON_SIZE> &extremes, Point p)
+{
+    double x = p.get_x(), y = p.get_y();
+    if (x < extremes[0].get_x())
+    {
+        extremes[0] = p;
+    }
+    if (x + y < extremes[1].get_x() + extremes[1].get_y())
+    {
+        extremes[1] = p;
+    }
+    if (y < extremes[2].get_y())
+    {
+        extremes[2] = p;
+    }
+    if (x - y > extremes[3].get_x() - extremes[3].get_y())
+    {
+        extremes[3] = p;
+    }
+    if (x > extremes[4].get_x())
+    {
+        extremes[4] = p;
+    }
+    if (x + y > extremes[5].get_x() + extremes[5].get_y())
+    {
+        extremes[5] = p;
+    }
+    if (y > extremes[6].get_y())
+    {
+        extremes[6] = p;
+    }
+    if (x - y < extremes[7].get_x() - extremes[7].get_y())
+    {
+        extremes[7] = p;
+    }
+}
+
+/**
+ * @brief Find the Akl-Toussaint octagon of a set of points in one parallel streaming pass
+ *
+ * @tparam PointAt a function from an index to the Point at that index
+ * @param count the number of points, must be positive
+ * @param point_at the accessor
+ * @param pool the pool running the chunks
+ * @param grain_size the minimum number of points in a chunk
+ * @return Octagon
+ */
+template <typename PointAt>
+Octagon find_octagon(size_t count, PointAt point_at, ThreadPool &pool, size_t grain_size)
+{
+    size_t chunk_count = parallel_chunk_count(pool, count, grain_size);
+    std::vector<std::array<Point, OCTAGON_SIZE>> chunk_extremes(chunk_count);
+
+    parallel_chunks(pool, 0, count, chunk_count, [&](size_t chunk, size_t chunk_begin, size_t chunk_end)
+                    {
+        std::array<Point, OCTAGON_SIZE> extremes;
+        extremes.fill(point_at(chunk_begin));
+        for (size_t i = chunk_begin + 1; i < chunk_end; i++)
+        {
+            update_octagon_extremes(extremes, point_at(i));
+        }
+        chunk_extremes[chunk] = extremes; });
+
+    Octagon octagon;
+    octagon.vertices = chunk_extremes[0];
+    for (size_t chunk = 1; chunk < chunk_count; chunk++)
+    {
+        for (Point p : chunk_extremes[chunk])
+        {
+            update_octagon_extremes(octagon.vertices, p);
+        }
+    }
+    octagon.build_edges();
+    return octagon;
+}
+
+/**
+ * @brief Remove the points strictly inside an octagon, keeping the order of the others
+ * every chunk compacts its survivors in place in parallel, then the chunks are moved next to each other
+ *
+ * @tparam Inside a function from an index to whether the point at that index is strictly inside
+ * @tparam MovePoint a function moving the point at a source index to a destination index, never after it
+ * @param count the number of points
+ * @param inside the test
+ * @param move_point the move
+ * @param pool the pool running the chunks
+ * @param grain_size the minimum number of points in a chunk
+ * @return size_t the number of points left, which are at the front
+ */
+template <typename Inside, typename MovePoint>
+size_t compact_outside_points(size_t count, Inside inside, MovePoint move_point, ThreadPool &pool, size_t grain_size)
+{
+    size_t chunk_count = parallel_chunk_count(pool, count, grain_size);
+    std::vector<size_t> chunk_begins(chunk_count), survivors(chunk_count);
+
+    parallel_chunks(pool, 0, count, chunk_count, [&](size_t chunk, size_t chunk_begin, size_t chunk_end)
+                    {
+        size_t kept = chunk_begin;
+        for (size_t i = chunk_begin; i < chunk_end; i++)
+        {
+            if (!inside(i))
+            {
+                move_point(i, kept++);
+            }
+        }
+        chunk_begins[chunk] = chunk_begin;
+        survivors[chunk] = kept - chunk_begin; });
+
+    size_t total = survivors[0];
+    for (size_t chunk = 1; chunk < chunk_count; chunk++)
+    {
+        for (size_t i = 0; i < survivors[chunk]; i++)
+        {
+            move_point(chunk_begins[chunk] + i, total + i);
+        }
+        total += survivors[chunk];
+    }
+    return total;
+}
+
+/**
+ * @brief Copy the points that are not strictly inside the Akl-Toussaint octagon of a read-only set
+ * the set is only read, in two parallel streaming passes, so it can be a view over memory the caller cannot or should not
+ * modify, such as a mapped file, and only the survivors are ever copied
+ *
+ * @tparam PointAt a function from an index to the Point at that index
+ * @param count the number of points
+ * @param point_at the accessor
+ * @param pool the pool running the passes
+ * @param grain_size the minimum number of points in a chunk
+ * @return std::vector<Point> the survivors, in their original order
+ */
+template <typename PointAt>
+std::vector<Point> gather_akl_toussaint_survivors(size_t count, PointAt point_at, ThreadPool &pool = default_thread_pool(), size_t grain_size = PREFILTER_GRAIN_SIZE)
+{
+    std::vector<Point> survivors;
+    if (count <= OCTAGON_SIZE)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            survivors.push_back(point_at(i));
+        }
+        return survivors;
+    }
+
+    Octagon octagon = find_octagon(count, point_at, pool, grain_size);
+    size_t chunk_count = parallel_chunk_count(pool, count, grain_size);
+    std::vector<std::vector<Point>> chunk_survivors(chunk_count);
+    parallel_chunks(pool, 0, count, chunk_count, [&](size_t chunk, size_t chunk_begin, size_t chunk_end)
+                    {
+        for (size_t i = chunk_begin; i < chunk_end; i++)
+        {
+            Point p = point_at(i);
+            if (!octagon.strictly_contains(p.get_x(), p.get_y()))
+            {
+                chunk_survivors[chunk].push_back(p);
+            }
+        } });
+
+    size_t total = 0;
+    for (const std::vector<Point> &chunk : chunk_survivors)
+    {
+        total += chunk.size();
+    }
+    survivors.reserve(total);
+    for (const std::vector<Point> &chunk : chunk_survivors)
+    {
+        survivors.insert(survivors.end(), chunk.begin(), chunk.end());
+    }
+    return survivors;
+}
+
+/**
+ * @brief Discard the points that are strictly inside the Akl-Toussaint octagon of the set, as they cannot be on its convex hull
+ * the octagon is found in one parallel pass, and the points are filtered in a second one
+ *
+ * @param points given set of points, only the survivors are left in it
+ * @param pool the pool running the passes
+ * @param grain_size the minimum number of points in a chunk
+ * @return size_t the number of points that survived
+ */
+size_t akl_toussaint_filter(std::vector<Point> &points, ThreadPool &pool = default_thread_pool(), size_t grain_size = PREFILTER_GRAIN_SIZE)
+{
+    if (points.size() <= OCTAGON_SIZE)
+    {
+        return points.size();
+    }
+
+    Octagon octagon = find_octagon(points.size(), [&points](size_t i)
+                                   { return points[i]; },
+                                   pool, grain_size);
+    size_t survivors = compact_outside_points(
+        points.size(), [&points, &octagon](size_t i)
+        { return octagon.strictly_contains(points[i].get_x(), points[i].get_y()); },
+        [&points](size_t from, size_t to)
+        { points[to] = points[from]; },
+        pool, grain_size);
+
+    points.resize(survivors);
+    return survivors;
+}
+
+/**
+ * @brief Discard the points of a structure-of-arrays buffer that are strictly inside its Akl-Toussaint octagon
+ *
+ * @param points given set of points, only the survivors are left in it
+ * @param pool the pool running the passes
+ * @param grain_size the minimum number of points in a chunk
+ * @return size_t the number of points that survived
+ */
+size_t akl_toussaint_filter(PointBuffer &points, ThreadPool &pool = default_thread_pool(), size_t grain_size = PREFILTER_GRAIN_SIZE)
+{
+    if (points.size() <= OCTAGON_SIZE)
+    {
+        return points.size();
+    }
+
+    double *xs = points.x(), *ys = points.y();
+    Octagon octagon = find_octagon(points.size(), [xs, ys](size_t i)
+                                   { return Point(xs[i], ys[i]); },
+                                   pool, grain_size);
+    size_t survivors = compact_outside_points(
+        points.size(), [xs, ys, &octagon](size_t i)
+        { return octagon.strictly_contains(xs[i], ys[i]); },
+        [xs, ys](size_t from, size_t to)
+        { xs[to] = xs[from]; ys[to] = ys[from]; },
+        pool, grain_size);
+
+    points.resize(survivors);
+    return survivors;
+}
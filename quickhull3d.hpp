@@ -0,0 +1,762 @@
+/**
+ * @file quickhull3d.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief The Quickhull algorithm in 3d, for point clouds, over a half-edge mesh with conflict lists
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "geometry.hpp"
+#include "thread_pool.hpp"
+
+#define QUICKHULL3D_GRAIN_SIZE 65536
+
+/**
+ * @brief A class to store a 3d point
+ */
+class Point3D
+{
+private:
+    /**
+     * @brief The points' coordinates in 3d
+     */
+    double x, y, z;
+
+public:
+    /**
+     * @brief Construct a new Point3D object at the origin
+     */
+    Point3D() : x(0), y(0), z(0)
+    {
+    }
+
+    /**
+     * @brief Construct a new Point3D object with given input
+     *
+     * @param x_to_set
+     * @param y_to_set
+     * @param z_to_set
+     */
+    Point3D(double x_to_set, double y_to_set, double z_to_set) : x(x_to_set), y(y_to_set), z(z_to_set)
+    {
+    }
+
+    double get_x() const
+    {
+        return x;
+    }
+
+    double get_y() const
+    {
+        return y;
+    }
+
+    double get_z() const
+    {
+        return z;
+    }
+
+    /**
+     * @brief Get the dot product with another vector
+     *
+     * @param other
+     * @return double
+     */
+    double dot(Point3D other) const
+    {
+        return x * other.x + y * other.y + z * other.z;
+    }
+
+    /**
+     * @brief Get the cross product with another vector
+     *
+     * @param other
+     * @return Point3D
+     */
+    Point3D cross(Point3D other) const
+    {
+        return Point3D(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x);
+    }
+
+    /**
+     * @brief Get the length of the vector
+     *
+     * @return double
+     */
+    double length() const
+    {
+        return sqrt(dot(*this));
+    }
+
+    /**
+     * @brief overload subtraction operator, the vector from other to this point
+     *
+     * @param other
+     * @return Point3D
+     */
+    Point3D operator-(Point3D other) const
+    {
+        return Point3D(x - other.x, y - other.y, z - other.z);
+    }
+
+    /**
+     * @brief overload less than operator, to sort points lexicographically
+     *
+     * @param other
+     * @return true if this point comes first, by x, then y, then z
+     * @return false otherwise
+     */
+    bool operator<(Point3D other) const
+    {
+        return x != other.x ? x < other.x : y != other.y ? y < other.y : z < other.z;
+    }
+
+    /**
+     * @brief overload equal operator
+     *
+     * @param other
+     * @return true if the points are the same
+     * @return false otherwise
+     */
+    bool operator==(Point3D other) const
+    {
+        return x == other.x && y == other.y && z == other.z;
+    }
+};
+
+/**
+ * @brief The relative error bound of the triple product of orient3d, as for ORIENT2D_ERROR_BOUND (Shewchuk)
+ */
+#define ORIENT3D_ERROR_BOUND ((7.0 + 56.0 * 0x1.0p-53) * 0x1.0p-53)
+#define ORIENT3D_EXPANSION_SIZE 96
+
+/**
+ * @brief Get the exact sign of the triple product of orient3d
+ * the determinant of the four points with a column of ones is expanded into 24 products of three coordinates, each
+ * split exactly into four doubles, and summed into an expansion like in orient2d_exact
+ *
+ * @param a
+ * @param b
+ * @param c
+ * @param d
+ * @return double a value with the exact sign of the triple product
+ */
+double orient3d_exact(Point3D a, Point3D b, Point3D c, Point3D d)
+{
+    const Point3D rows[4] = {a, b, c, d};
+    double expansion[ORIENT3D_EXPANSION_SIZE];
+    size_t length = 0;
+    // the row of every column, over all the permutations; the triple product is minus the determinant
+    int permutation[4] = {0, 1, 2, 3};
+    do
+    {
+        int inversions = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            for (int j = i + 1; j < 4; j++)
+            {
+                inversions += permutation[i] > permutation[j];
+            }
+        }
+        double x = inversions % 2 == 0 ? -rows[permutation[0]].get_x() : rows[permutation[0]].get_x();
+        double product, product_error, terms[4];
+        two_product(x, rows[permutation[1]].get_y(), product, product_error);
+        two_product(product, rows[permutation[2]].get_z(), terms[3], terms[2]);
+        two_product(product_error, rows[permutation[2]].get_z(), terms[1], terms[0]);
+        for (double term : terms)
+        {
+            size_t grown = 0;
+            for (size_t j = 0; j < length; j++)
+            {
+                double error;
+                two_sum(term, expansion[j], term, error);
+                if (error != 0)
+                {
+                    expansion[grown++] = error;
+                }
+            }
+            if (term != 0)
+            {
+                expansion[grown++] = term;
+            }
+            length = grown;
+        }
+    } while (std::next_permutation(permutation, permutation + 4));
+    return length == 0 ? 0 : expansion[length - 1];
+}
+
+/**
+ * @brief Get the orientation of four points, robustly
+ * the triple product is computed in floating point first, and only recomputed exactly when it is too close to zero for
+ * its sign to be trusted
+ *
+ * @param a
+ * @param b
+ * @param c
+ * @param d
+ * @return double positive if d is above the plane of the counter-clockwise triangle a, b, c, negative if below, zero if
+ * the four points are coplanar, always with the exact sign
+ */
+inline double orient3d(Point3D a, Point3D b, Point3D c, Point3D d)
+{
+    Point3D u = b - a, v = c - a, w = d - a;
+    double vw_x = v.get_y() * w.get_z(), wv_x = v.get_z() * w.get_y();
+    double vw_y = v.get_z() * w.get_x(), wv_y = v.get_x() * w.get_z();
+    double vw_z = v.get_x() * w.get_y(), wv_z = v.get_y() * w.get_x();
+    double product = u.get_x() * (vw_x - wv_x) + u.get_y() * (vw_y - wv_y) + u.get_z() * (vw_z - wv_z);
+    double permanent = std::fabs(u.get_x()) * (std::fabs(vw_x) + std::fabs(wv_x)) + std::fabs(u.get_y()) * (std::fabs(vw_y) + std::fabs(wv_y)) +
+                       std::fabs(u.get_z()) * (std::fabs(vw_z) + std::fabs(wv_z));
+    double bound = ORIENT3D_ERROR_BOUND * permanent;
+    if (product > bound || -product > bound) [[likely]]
+    {
+        return product;
+    }
+    return orient3d_exact(a, b, c, d);
+}
+
+/**
+ * @brief The convex hull of a point cloud, as a triangle mesh
+ */
+struct Hull3D
+{
+    /**
+     * @brief The vertices of the hull
+     */
+    vector<Point3D> vertices;
+
+    /**
+     * @brief The triangles of the hull, as indices into the vertices, counter-clockwise when seen from outside; coplanar
+     * faces are split into triangles
+     */
+    vector<std::array<uint32_t, 3>> faces;
+
+    /**
+     * @brief The index of every vertex in the input points
+     */
+    vector<uint32_t> input_indices;
+};
+
+/**
+ * @brief Quickhull in 3d over a half-edge mesh of triangles
+ * every face keeps the conflict list of the points outside of it, and its farthest one; a face with conflicts is taken,
+ * the faces its farthest point (the eye) sees are found by walking the mesh, their border is the horizon, the visible
+ * faces are replaced by a cone of new faces from the horizon to the eye, and their conflict points are assigned to the
+ * new faces, or dropped when they are inside. A point is outside a face only when it is farther than a tolerance from
+ * its plane, scaled to the coordinates like in qhull, so points that are nearly coplanar with a face are never added;
+ * the visible faces and the conflicts are also checked with the exact orient3d, so the mesh is always exactly convex
+ * and a point dropped as inside stays inside, even when rounding gives long, thin faces
+ *
+ * the faces and their conflict lists are pooled: a deleted face goes to a free list, and the next new face reuses its
+ * slot and the memory of its conflict list. The three half-edges of a face are stored at 3 * face + 0, 1, 2, so they are
+ * pooled with it, and an edge only stores its head and its twin
+ */
+class QuickHull3D
+{
+private:
+    struct Face
+    {
+        /**
+         * @brief The unit normal of the plane of the face, pointing outside, and its offset from the origin
+         */
+        Point3D normal;
+        double offset;
+
+        /**
+         * @brief The distance from the plane past which the rounding of distance cannot change the side of a point
+         */
+        double margin;
+
+        /**
+         * @brief The points outside of the face, and the farthest one
+         */
+        vector<uint32_t> conflicts;
+        uint32_t farthest;
+        double farthest_distance;
+
+        /**
+         * @brief The last iterations the face was tested for visibility and found visible
+         */
+        size_t tested, visible;
+
+        bool alive;
+    };
+
+    struct HalfEdge
+    {
+        uint32_t head, twin;
+    };
+
+    std::span<const Point3D> points;
+    ThreadPool &pool;
+    size_t grain_size;
+    double tolerance;
+
+    vector<Face> faces;
+    vector<HalfEdge> edges;
+    vector<uint32_t> free_faces, pending;
+    size_t iteration;
+
+    // scratch buffers, reused from one iteration to the next
+    vector<uint32_t> visible_faces, horizon, new_faces, horizon_from, orphans, targets;
+    vector<double> distances;
+
+    static uint32_t next_edge(uint32_t edge)
+    {
+        return edge - edge % 3 + (edge % 3 + 1) % 3;
+    }
+
+    uint32_t tail(uint32_t edge) const
+    {
+        return edges[next_edge(next_edge(edge))].head;
+    }
+
+    double distance(uint32_t face, uint32_t point) const
+    {
+        return faces[face].normal.dot(points[point]) - faces[face].offset;
+    }
+
+    /**
+     * @brief Check if a point is above the plane of a face, exactly
+     * its distance from the plane decides when it is past the margin of the face, and orient3d otherwise
+     *
+     * @param face
+     * @param point
+     * @param point_distance the distance of the point from the face
+     * @return true if the point is strictly outside the face
+     * @return false otherwise
+     */
+    bool above(uint32_t face, uint32_t point, double point_distance) const
+    {
+        if (std::abs(point_distance) > faces[face].margin)
+        {
+            return point_distance > 0;
+        }
+        return orient3d(points[edges[3 * face + 2].head], points[edges[3 * face].head], points[edges[3 * face + 1].head], points[point]) > 0;
+    }
+
+    /**
+     * @brief Add the triangle a, b, c, from the free list if possible
+     *
+     * @return uint32_t the new face
+     */
+    uint32_t add_face(uint32_t a, uint32_t b, uint32_t c)
+    {
+        uint32_t face;
+        if (free_faces.empty())
+        {
+            face = (uint32_t)faces.size();
+            faces.emplace_back();
+            edges.resize(edges.size() + 3);
+        }
+        else
+        {
+            face = free_faces.back();
+            free_faces.pop_back();
+        }
+        Face &f = faces[face];
+        // the cross product of the two edges around the widest angle, which are the farthest from parallel, so that the
+        // normal of a sliver with a very short edge is still accurate
+        Point3D ab = points[b] - points[a], bc = points[c] - points[b], ca = points[a] - points[c];
+        double ab_length = ab.dot(ab), bc_length = bc.dot(bc), ca_length = ca.dot(ca);
+        Point3D normal = bc_length >= ab_length && bc_length >= ca_length ? ca.cross(ab) : ca_length >= ab_length ? ab.cross(bc) : bc.cross(ca);
+        double length = normal.length();
+        f.normal = length > 0 ? Point3D(normal.get_x() / length, normal.get_y() / length, normal.get_z() / length) : Point3D();
+        f.offset = f.normal.dot(points[a]);
+        // the angle of the normal is off by a few ulps over the sine of the widest angle, and the distances by a few ulps
+        // of the coordinates, both covered by a few times the tolerance
+        double spread = std::sqrt(ab_length * bc_length * ca_length / std::max({ab_length, bc_length, ca_length}));
+        f.margin = length > 0 ? tolerance * (8 + 8 * spread / length) : INFINITY;
+        f.conflicts.clear();
+        f.tested = f.visible = 0;
+        f.alive = true;
+        edges[3 * face] = {b, 0};
+        edges[3 * face + 1] = {c, 0};
+        edges[3 * face + 2] = {a, 0};
+        return face;
+    }
+
+    /**
+     * @brief Add a point to the conflict list of a face
+     * among points equally far from the face, up to the tolerance, the lexicographically smallest one is kept as the
+     * farthest: it is a vertex of the hull, while a point in the middle of a flat region of ties would stay in the hull as
+     * a vertex that is not a corner
+     *
+     * @param face
+     * @param point
+     * @param point_distance the distance of the point from the face
+     */
+    void add_conflict(uint32_t face, uint32_t point, double point_distance)
+    {
+        Face &f = faces[face];
+        if (f.conflicts.empty() || point_distance > f.farthest_distance + tolerance ||
+            (point_distance >= f.farthest_distance - tolerance && points[point] < points[f.farthest]))
+        {
+            f.farthest_distance = point_distance;
+            f.farthest = point;
+        }
+        f.conflicts.push_back(point);
+    }
+
+    void link(uint32_t edge, uint32_t twin)
+    {
+        edges[edge].twin = twin;
+        edges[twin].twin = edge;
+    }
+
+    /**
+     * @brief Assign points to the first of some faces they are outside of, and drop the others
+     * the faces are found in parallel when there are many points, then the points are appended to the conflict lists in
+     * their order, so the result does not depend on the threads
+     *
+     * @param to_assign the points
+     * @param candidates the faces
+     */
+    void assign_conflicts(const vector<uint32_t> &to_assign, const vector<uint32_t> &candidates)
+    {
+        size_t count = to_assign.size();
+        targets.resize(count);
+        distances.resize(count);
+        parallel_chunks(pool, 0, count, parallel_chunk_count(pool, count, grain_size), [&](size_t, size_t chunk_begin, size_t chunk_end)
+                        {
+            for (size_t i = chunk_begin; i < chunk_end; i++)
+            {
+                targets[i] = UINT32_MAX;
+                for (uint32_t face : candidates)
+                {
+                    double d = distance(face, to_assign[i]);
+                    if (d > tolerance && above(face, to_assign[i], d))
+                    {
+                        targets[i] = face;
+                        distances[i] = d;
+                        break;
+                    }
+                }
+            } });
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (targets[i] != UINT32_MAX)
+            {
+                add_conflict(targets[i], to_assign[i], distances[i]);
+            }
+        }
+        for (uint32_t face : candidates)
+        {
+            if (!faces[face].conflicts.empty())
+            {
+                pending.push_back(face);
+            }
+        }
+    }
+
+    /**
+     * @brief Find four points spanning a tetrahedron, from the extreme points on every axis
+     *
+     * @param simplex output, the four points
+     * @return true if they were found
+     * @return false if the points are coplanar, up to the tolerance
+     */
+    bool find_simplex(uint32_t simplex[4])
+    {
+        // the lowest and highest points on every axis, ties broken by the next axes, so that they are vertices
+        uint32_t extremes[6] = {0, 0, 0, 0, 0, 0};
+        double scale = 0;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            auto key = [axis](Point3D p)
+            {
+                return axis == 0 ? p : axis == 1 ? Point3D(p.get_y(), p.get_z(), p.get_x()) : Point3D(p.get_z(), p.get_x(), p.get_y());
+            };
+            for (uint32_t i = 0; i < points.size(); i++)
+            {
+                extremes[2 * axis] = key(points[i]) < key(points[extremes[2 * axis]]) ? i : extremes[2 * axis];
+                extremes[2 * axis + 1] = key(points[extremes[2 * axis + 1]]) < key(points[i]) ? i : extremes[2 * axis + 1];
+            }
+            scale += std::max(std::abs(key(points[extremes[2 * axis]]).get_x()), std::abs(key(points[extremes[2 * axis + 1]]).get_x()));
+        }
+        tolerance = 3 * DBL_EPSILON * scale;
+
+        // the farthest point by some measure, among the ones equally far up to the tolerance the lexicographically smallest
+        auto farthest = [this](auto measure, double measure_tolerance, double &best)
+        {
+            uint32_t best_point = 0;
+            best = 0;
+            for (uint32_t i = 0; i < points.size(); i++)
+            {
+                double value = measure(points[i]);
+                if (value > best + measure_tolerance || (value >= best - measure_tolerance && points[i] < points[best_point]))
+                {
+                    best = max(best, value);
+                    best_point = i;
+                }
+            }
+            return best_point;
+        };
+
+        // the two farthest extreme points, the point farthest from their line, and the point farthest from their plane
+        double best = 0;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            double length = (points[extremes[2 * axis + 1]] - points[extremes[2 * axis]]).length();
+            if (length > best)
+            {
+                best = length;
+                simplex[0] = extremes[2 * axis];
+                simplex[1] = extremes[2 * axis + 1];
+            }
+        }
+        if (best <= tolerance)
+        {
+            return false;
+        }
+
+        Point3D origin = points[simplex[0]], direction = points[simplex[1]] - origin;
+        simplex[2] = farthest([&](Point3D p)
+                              { return direction.cross(p - origin).length(); }, tolerance * direction.length(), best);
+        if (best / direction.length() <= tolerance)
+        {
+            return false;
+        }
+
+        Point3D normal = direction.cross(points[simplex[2]] - origin);
+        simplex[3] = farthest([&](Point3D p)
+                              { return std::abs(normal.dot(p - origin)); }, tolerance * normal.length(), best);
+        if (best / normal.length() <= tolerance)
+        {
+            return false;
+        }
+        // the fourth point must be below the plane of the first three
+        if (orient3d(points[simplex[0]], points[simplex[1]], points[simplex[2]], points[simplex[3]]) > 0)
+        {
+            std::swap(simplex[1], simplex[2]);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Add the farthest point of a face to the hull
+     *
+     * @param face
+     */
+    void add_point(uint32_t face)
+    {
+        uint32_t eye = faces[face].farthest;
+        iteration++;
+
+        // the faces the eye sees form a connected region around the face
+        visible_faces.assign(1, face);
+        faces[face].tested = faces[face].visible = iteration;
+        for (size_t k = 0; k < visible_faces.size(); k++)
+        {
+            for (uint32_t edge = 3 * visible_faces[k]; edge < 3 * visible_faces[k] + 3; edge++)
+            {
+                uint32_t neighbor = edges[edge].twin / 3;
+                if (faces[neighbor].tested != iteration)
+                {
+                    faces[neighbor].tested = iteration;
+                    if (above(neighbor, eye, distance(neighbor, eye)))
+                    {
+                        faces[neighbor].visible = iteration;
+                        visible_faces.push_back(neighbor);
+                    }
+                }
+            }
+        }
+
+        // the horizon: the edges of the visible faces whose twins are not visible, chained head to tail
+        size_t horizon_size = 0;
+        uint32_t start = UINT32_MAX;
+        for (uint32_t visible : visible_faces)
+        {
+            for (uint32_t edge = 3 * visible; edge < 3 * visible + 3; edge++)
+            {
+                if (faces[edges[edge].twin / 3].visible != iteration)
+                {
+                    horizon_from[tail(edge)] = edge;
+                    start = edge;
+                    horizon_size++;
+                }
+            }
+        }
+        auto on_horizon = [&](uint32_t edge)
+        {
+            return faces[edge / 3].visible == iteration && faces[edges[edge].twin / 3].visible != iteration;
+        };
+        horizon.clear();
+        uint32_t next = start;
+        do
+        {
+            horizon.push_back(next);
+            next = horizon_from[edges[next].head];
+        } while (horizon.size() < horizon_size && next != start && on_horizon(next));
+        if (horizon.size() != horizon_size || next != start)
+        {
+            // rounding made the visible region pinch at a vertex, so the eye is dropped rather than breaking the mesh; the
+            // other points are added again, which also finds the new farthest one
+            orphans.clear();
+            orphans.swap(faces[face].conflicts);
+            auto dropped = find(orphans.begin(), orphans.end(), eye);
+            if (dropped != orphans.end())
+            {
+                orphans.erase(dropped);
+            }
+            for (uint32_t point : orphans)
+            {
+                add_conflict(face, point, distance(face, point));
+            }
+            if (!faces[face].conflicts.empty())
+            {
+                pending.push_back(face);
+            }
+            return;
+        }
+
+        // the cone of new faces from the horizon to the eye, each sharing an edge with the next one
+        new_faces.clear();
+        for (uint32_t edge : horizon)
+        {
+            uint32_t outside_twin = edges[edge].twin, new_face = add_face(tail(edge), edges[edge].head, eye);
+            link(3 * new_face, outside_twin);
+            new_faces.push_back(new_face);
+        }
+        for (size_t k = 0; k < new_faces.size(); k++)
+        {
+            link(3 * new_faces[k] + 1, 3 * new_faces[(k + 1) % new_faces.size()] + 2);
+        }
+
+        // the conflict points of the visible faces move to the new faces, and the visible faces are freed
+        orphans.clear();
+        for (uint32_t visible : visible_faces)
+        {
+            for (uint32_t point : faces[visible].conflicts)
+            {
+                if (point != eye)
+                {
+                    orphans.push_back(point);
+                }
+            }
+            faces[visible].conflicts.clear();
+            faces[visible].alive = false;
+            free_faces.push_back(visible);
+        }
+        assign_conflicts(orphans, new_faces);
+    }
+
+public:
+    /**
+     * @brief Construct a new QuickHull3D object
+     *
+     * @param points_to_hull the points
+     * @param pool_to_use the pool assigning the conflict points when there are many of them
+     * @param grain_size_to_use the minimum number of points in a chunk of the assignment
+     */
+    QuickHull3D(std::span<const Point3D> points_to_hull, ThreadPool &pool_to_use, size_t grain_size_to_use)
+        : points(points_to_hull), pool(pool_to_use), grain_size(grain_size_to_use), tolerance(0), iteration(0)
+    {
+    }
+
+    /**
+     * @brief Find the hull
+     *
+     * @param hull output
+     * @return true if the hull was found
+     * @return false if there are less than four points, more than UINT32_MAX, or they are coplanar
+     */
+    bool build(Hull3D &hull)
+    {
+        hull.vertices.clear();
+        hull.faces.clear();
+        hull.input_indices.clear();
+        uint32_t simplex[4];
+        if (points.size() < 4 || points.size() >= UINT32_MAX || !find_simplex(simplex))
+        {
+            return false;
+        }
+
+        // the tetrahedron, with the fourth point below the first face
+        uint32_t a = simplex[0], b = simplex[1], c = simplex[2], d = simplex[3];
+        uint32_t tetrahedron[4] = {add_face(a, b, c), add_face(a, d, b), add_face(b, d, c), add_face(c, d, a)};
+        for (uint32_t first = 0; first < 12; first++)
+        {
+            for (uint32_t second = first + 1; second < 12; second++)
+            {
+                if (edges[first].head == tail(second) && tail(first) == edges[second].head)
+                {
+                    link(first, second);
+                }
+            }
+        }
+
+        horizon_from.resize(points.size());
+        vector<uint32_t> all(points.size());
+        for (uint32_t i = 0; i < points.size(); i++)
+        {
+            all[i] = i;
+        }
+        assign_conflicts(all, vector<uint32_t>(tetrahedron, tetrahedron + 4));
+        all = vector<uint32_t>();
+
+        while (!pending.empty())
+        {
+            uint32_t face = pending.back();
+            pending.pop_back();
+            if (faces[face].alive && !faces[face].conflicts.empty())
+            {
+                add_point(face);
+            }
+        }
+
+        // the live faces, with their vertices numbered in the order they are met
+        vector<uint32_t> &numbers = horizon_from;
+        fill(numbers.begin(), numbers.end(), UINT32_MAX);
+        for (uint32_t face = 0; face < faces.size(); face++)
+        {
+            if (!faces[face].alive)
+            {
+                continue;
+            }
+            std::array<uint32_t, 3> triangle;
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                uint32_t vertex = edges[3 * face + (k + 2) % 3].head;
+                if (numbers[vertex] == UINT32_MAX)
+                {
+                    numbers[vertex] = (uint32_t)hull.vertices.size();
+                    hull.vertices.push_back(points[vertex]);
+                    hull.input_indices.push_back(vertex);
+                }
+                triangle[k] = numbers[vertex];
+            }
+            hull.faces.push_back(triangle);
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief A function to find the convex hull of a point cloud using the Quickhull algorithm in 3d
+ * on most clouds it runs in O(nlog(n)), and every point is only tested against the faces near where it is assigned
+ *
+ * @param points the point cloud
+ * @param hull output, the triangles of the hull
+ * @param pool the pool assigning the conflict points when there are many of them
+ * @param grain_size the minimum number of points in a chunk of the assignment
+ * @return true if the hull was found
+ * @return false if there are less than four points, or they are coplanar, so the hull has no volume
+ */
+bool quick_hull_3d(std::span<const Point3D> points, Hull3D &hull, ThreadPool &pool = default_thread_pool(), size_t grain_size = QUICKHULL3D_GRAIN_SIZE)
+{
+    QuickHull3D builder(points, pool, grain_size);
+    return builder.build(hull);
+}
@@ -0,0 +1,259 @@
+/**
+ * @file streaming_hull.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief An out-of-core convex hull, reading the points in fixed-size chunks from a file or a stream
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "geometry.hpp"
+#include "convex_hull.hpp"
+#include "merge_hull.hpp"
+#include "point_file.hpp"
+#include "thread_pool.hpp"
+
+#define STREAMING_CHUNK_SIZE (1 << 20)
+
+/**
+ * @brief A reader handing out the points of a stream chunk by chunk
+ * the stream is either a point file, in any layout, or raw x, y pairs of doubles without a header; a point file in the
+ * structure of arrays layout is read from two positions, so it must be seekable
+ */
+class PointStreamReader
+{
+private:
+    FILE *input;
+
+    /**
+     * @brief The points read while looking for a header, handed out before the rest of the stream
+     */
+    Point sniffed[POINT_FILE_HEADER_SIZE / sizeof(Point)];
+    size_t sniffed_count, sniffed_index;
+
+    bool has_header, failed;
+    PointFileHeader header;
+
+    /**
+     * @brief The number of points handed out so far
+     */
+    uint64_t position;
+
+    /**
+     * @brief Scratch for the coordinates of a structure of arrays file
+     */
+    std::vector<double> xs, ys;
+
+    size_t read_interleaved(Point *points, size_t count)
+    {
+        size_t bytes = fread(static_cast<void *>(points), 1, count * sizeof(Point), input);
+        // a short read only happens at the end of the stream, which must end on a whole point
+        if (ferror(input) || bytes % sizeof(Point) != 0)
+        {
+            failed = true;
+        }
+        return bytes / sizeof(Point);
+    }
+
+    size_t read_separated(Point *points, size_t count)
+    {
+        xs.resize(count);
+        ys.resize(count);
+        long x_offset = (long)(POINT_FILE_HEADER_SIZE + position * sizeof(double));
+        long y_offset = (long)(POINT_FILE_HEADER_SIZE + (header.count + position) * sizeof(double));
+        if (fseek(input, x_offset, SEEK_SET) != 0 || fread(xs.data(), sizeof(double), count, input) != count ||
+            fseek(input, y_offset, SEEK_SET) != 0 || fread(ys.data(), sizeof(double), count, input) != count)
+        {
+            failed = true;
+            return 0;
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            points[i] = Point(xs[i], ys[i]);
+        }
+        return count;
+    }
+
+public:
+    /**
+     * @brief Construct a new Point Stream Reader object, reading the header if the stream starts with one
+     *
+     * @param input_to_set a stream opened for binary reading
+     */
+    explicit PointStreamReader(FILE *input_to_set)
+        : input(input_to_set), sniffed_count(0), sniffed_index(0), has_header(false), failed(false), position(0)
+    {
+        std::memset(&header, 0, sizeof(header));
+        uint8_t bytes[POINT_FILE_HEADER_SIZE];
+        size_t read = fread(bytes, 1, POINT_FILE_HEADER_SIZE, input);
+        if (read == POINT_FILE_HEADER_SIZE && std::memcmp(bytes, POINT_FILE_MAGIC, POINT_FILE_MAGIC_SIZE) == 0)
+        {
+            std::memcpy(&header, bytes, sizeof(header));
+            has_header = true;
+            failed = header.version != POINT_FILE_VERSION || header.layout > (uint32_t)PointLayout::STRUCTURE_OF_ARRAYS;
+            return;
+        }
+        // without a header, the bytes read so far are the first points
+        failed = read % sizeof(Point) != 0;
+        sniffed_count = read / sizeof(Point);
+        std::memcpy(static_cast<void *>(sniffed), bytes, sniffed_count * sizeof(Point));
+    }
+
+    /**
+     * @brief Read the next points
+     *
+     * @param points where the points are written
+     * @param count the maximum number of points to read
+     * @return size_t the number of points read, 0 at the end of the stream or after an error
+     */
+    size_t read(Point *points, size_t count)
+    {
+        if (failed)
+        {
+            return 0;
+        }
+        if (has_header)
+        {
+            count = (size_t)std::min((uint64_t)count, header.count - position);
+        }
+
+        size_t read = 0;
+        while (sniffed_index < sniffed_count && read < count)
+        {
+            points[read++] = sniffed[sniffed_index++];
+        }
+        if (read < count)
+        {
+            read += has_header && header.layout == (uint32_t)PointLayout::STRUCTURE_OF_ARRAYS ? read_separated(points + read, count - read)
+                                                                                               : read_interleaved(points + read, count - read);
+        }
+        position += read;
+        return read;
+    }
+
+    /**
+     * @brief Check if the whole stream was read without an error
+     * a point file must hold as many points as its header says
+     *
+     * @return true if the stream was valid and fully read
+     * @return false otherwise
+     */
+    bool complete() const
+    {
+        return !failed && (!has_header || position == header.count);
+    }
+};
+
+/**
+ * @brief The result of a streaming convex hull, with its throughput
+ */
+struct StreamingHullResult
+{
+    /**
+     * @brief The convex hull, in counter-clockwise order starting from the lowest leftmost point
+     */
+    vector<Point> hull;
+
+    /**
+     * @brief The number of points and of chunks read
+     */
+    uint64_t points = 0, chunks = 0;
+
+    /**
+     * @brief The wall-clock time taken, reading included
+     */
+    double seconds = 0;
+
+    /**
+     * @brief Whether the whole input was read without an error, the hull only covers the points read otherwise
+     */
+    bool complete = false;
+
+    /**
+     * @brief Get the throughput
+     *
+     * @return double the number of points processed per second
+     */
+    double points_per_second() const
+    {
+        return seconds > 0 ? (double)points / seconds : 0;
+    }
+};
+
+/**
+ * @brief A function to find the convex hull of a stream of points with bounded memory
+ * the points are read in chunks, every chunk is reduced to its hull, and the partial hull is merged into the running one
+ * in linear time, so at most two chunks and the running hull are kept in memory, whatever the size of the input;
+ * the next chunk is read in the pool while the current one is processed
+ *
+ * @param input a stream opened for binary reading, such as stdin, holding a point file or raw x, y pairs
+ * @param chunk_size the number of points in a chunk
+ * @param algorithm the engine run on every chunk
+ * @param pool the pool reading the chunks and running the engines
+ * @return StreamingHullResult
+ */
+StreamingHullResult streaming_convex_hull(FILE *input, size_t chunk_size = STREAMING_CHUNK_SIZE, Algorithm algorithm = Algorithm::AUTOMATIC, ThreadPool &pool = default_thread_pool())
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    StreamingHullResult result;
+    chunk_size = std::max(chunk_size, (size_t)1);
+    PointStreamReader reader(input);
+    HullOptions options;
+    options.algorithm = algorithm;
+
+    std::vector<Point> current(chunk_size), next(chunk_size);
+    size_t current_count = reader.read(current.data(), chunk_size);
+    while (current_count > 0)
+    {
+        size_t next_count = 0;
+        TaskGroup group(pool);
+        group.run([&reader, &next, &next_count, chunk_size]
+                  { next_count = reader.read(next.data(), chunk_size); });
+
+        vector<Point> chunk_hull = convex_hull(std::span<const Point>(current.data(), current_count), options);
+        result.hull = merge_hulls(result.hull, chunk_hull);
+        result.points += current_count;
+        result.chunks++;
+
+        group.wait();
+        std::swap(current, next);
+        current_count = next_count;
+    }
+
+    result.complete = reader.complete();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+/**
+ * @brief A function to find the convex hull of a file of points with bounded memory
+ *
+ * @param filename the file, or "-" for the standard input
+ * @param chunk_size the number of points in a chunk
+ * @param algorithm the engine run on every chunk
+ * @param pool the pool reading the chunks and running the engines
+ * @return StreamingHullResult not complete if the file could not be opened
+ */
+StreamingHullResult streaming_convex_hull(const char *filename, size_t chunk_size = STREAMING_CHUNK_SIZE, Algorithm algorithm = Algorithm::AUTOMATIC, ThreadPool &pool = default_thread_pool())
+{
+    if (std::strcmp(filename, "-") == 0)
+    {
+        return streaming_convex_hull(stdin, chunk_size, algorithm, pool);
+    }
+    FILE *input = fopen(filename, "rb");
+    if (input == nullptr)
+    {
+        return StreamingHullResult();
+    }
+    StreamingHullResult result = streaming_convex_hull(input, chunk_size, algorithm, pool);
+    fclose(input);
+    return result;
+}
@@ -1,2 +1,2 @@
-g++ ./tests/test.cpp -Wall -Wextra -Wconversion -Wsign-conversion -Wshadow -Wpedantic -std=c++20 -o ./tests/test.out
+g++ ./tests/test.cpp -Wall -Wextra -Wconversion -Wsign-conversion -Wshadow -Wpedantic -std=c++20 -pthread -o ./tests/test.out
 ./tests/test.out
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "../tester.hpp"
+#include "../approximate_hull.hpp"
+#include "../generator.hpp"
+
+// the distance from a point to a convex polygon in counter-clockwise order, 0 inside
+double distance_to_convex_polygon(Point p, const std::vector<Point> &polygon)
+{
+    if (polygon.size() == 1)
+    {
+        return p.distance_to(polygon[0]);
+    }
+    bool inside = polygon.size() >= 3;
+    double distance = INF_DOUBLE;
+    for (size_t i = 0; i < polygon.size(); i++)
+    {
+        Point a = polygon[i], b = polygon[(i + 1) % polygon.size()];
+        inside = inside && orient2d(a, b, p) >= 0;
+        double dx = b.get_x() - a.get_x(), dy = b.get_y() - a.get_y();
+        double t = std::clamp(((p.get_x() - a.get_x()) * dx + (p.get_y() - a.get_y()) * dy) / (dx * dx + dy * dy), 0.0, 1.0);
+        distance = min(distance, p.distance_to(Point(a.get_x() + t * dx, a.get_y() + t * dy)));
+    }
+    return inside ? 0 : distance;
+}
+
+void test_approximate_hull_error_bound()
+{
+    ThreadPool pool(4);
+    bool all_within = true, all_inside = true, all_shrink = true;
+    for (PointDistribution distribution : {PointDistribution::UNIFORM_SQUARE, PointDistribution::UNIFORM_DISK, PointDistribution::CIRCLE,
+                                           PointDistribution::GAUSSIAN, PointDistribution::CLUSTERED, PointDistribution::DUPLICATES})
+    {
+        std::vector<Point> points = generate_points(5000, distribution, 7);
+        std::vector<Point> exact = monotone_chain(points);
+        double previous_error = INF_DOUBLE;
+        for (size_t strip_count : {(size_t)1, (size_t)4, (size_t)32, (size_t)256})
+        {
+            ApproximateHull approximate = approximate_hull(points, strip_count, pool, 256);
+            all_shrink = all_shrink && approximate.error_bound < previous_error;
+            previous_error = approximate.error_bound;
+            all_shrink = all_shrink && approximate.hull.size() <= 2 * strip_count + 2;
+            for (Point p : points)
+            {
+                all_within = all_within && distance_to_convex_polygon(p, approximate.hull) <= approximate.error_bound * (1 + 1e-9);
+            }
+            // the hull is made of input points, so it is inside the exact hull
+            for (Point p : approximate.hull)
+            {
+                all_inside = all_inside && distance_to_convex_polygon(p, exact) == 0;
+            }
+            all_inside = all_inside && approximate.hull == monotone_chain(approximate.hull);
+            all_inside = all_inside && approximate.hull.front() == exact.front();
+        }
+    }
+    IS_TRUE(all_within);
+    IS_TRUE(all_inside);
+    IS_TRUE(all_shrink);
+
+    // with few points in each strip, the hull is exact
+    std::vector<Point> circle = generate_points(100, PointDistribution::CIRCLE, 3);
+    ApproximateHull fine = approximate_hull(circle, 1 << 16);
+    IS_TRUE(fine.hull == monotone_chain(circle));
+}
+
+void test_approximate_hull_inputs()
+{
+    // the chunks give the same hull as one pass, for an array of structures and a structure of arrays
+    std::vector<Point> points = generate_points(100000, PointDistribution::GAUSSIAN, 5);
+    ThreadPool pool(4), one(1);
+    ApproximateHull parallel = approximate_hull(points, 64, pool, 1000), serial = approximate_hull(points, 64, one);
+    IS_TRUE(parallel.hull == serial.hull);
+    IS_EQUAL(parallel.error_bound, serial.error_bound);
+    IS_TRUE(approximate_hull(PointBuffer(points), 64, pool, 1000).hull == serial.hull);
+
+    IS_TRUE(approximate_hull(std::vector<Point>()).hull.empty());
+    std::vector<Point> point = {Point(1, 2), Point(1, 2)};
+    IS_TRUE(approximate_hull(point).hull == std::vector<Point>{Point(1, 2)});
+    IS_EQUAL(approximate_hull(point).error_bound, 0.0);
+
+    // no x extent: the lowest and the highest point
+    std::vector<Point> vertical = {Point(3, 1), Point(3, -4), Point(3, 2), Point(3, 0)};
+    ApproximateHull line = approximate_hull(vertical, 8);
+    IS_TRUE(line.hull == (std::vector<Point>{Point(3, -4), Point(3, 2)}));
+    IS_EQUAL(line.error_bound, 0.0);
+
+    std::vector<Point> square = {Point(0, 0), Point(4, 0), Point(4, 4), Point(0, 4), Point(2, 2), Point(1, 3)};
+    ApproximateHull corners = approximate_hull(square, 2);
+    IS_TRUE(corners.hull == (std::vector<Point>{Point(0, 0), Point(4, 0), Point(4, 4), Point(0, 4)}));
+    IS_EQUAL(corners.error_bound, 2.0);
+}
+
+void test_approximate_hull()
+{
+    test_approximate_hull_error_bound();
+
+    test_approximate_hull_inputs();
+}
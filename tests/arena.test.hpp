@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "../tester.hpp"
+#include "../arena.hpp"
+#include "../convex_hull.hpp"
+#include "../generator.hpp"
+
+void test_counting_resource()
+{
+    CountingResource counter;
+    {
+        std::pmr::vector<int> values(&counter);
+        values.resize(100);
+    }
+    IS_EQUAL(counter.allocations(), 1);
+    IS_EQUAL(counter.deallocations(), 1);
+    IS_EQUAL(counter.bytes(), 100 * sizeof(int));
+}
+
+void test_hull_arena_allocations()
+{
+    CountingResource counter;
+    HullArena arena(&counter, 256);
+
+    void *first = arena.allocate(24, 8), *aligned = arena.allocate(64, 64);
+    IS_EQUAL((uintptr_t)aligned % 64, 0);
+    IS_TRUE(first != aligned);
+    // larger than the block, so a new block is needed
+    void *large = arena.allocate(1000, 8);
+    IS_TRUE(large != nullptr);
+    IS_EQUAL(counter.allocations(), 2);
+
+    // the two blocks are merged into one, which is then reused
+    arena.reset();
+    IS_EQUAL(counter.allocations(), 3);
+    IS_EQUAL(counter.deallocations(), 2);
+    first = arena.allocate(24, 8);
+    large = arena.allocate(1000, 8);
+    IS_TRUE(first != large);
+    arena.reset();
+    IS_EQUAL(counter.allocations(), 3);
+}
+
+void test_repeated_hulls_reach_zero_heap_allocations()
+{
+    CountingResource counter;
+    HullArena arena(&counter, 1024);
+    std::vector<Point> points = generate_points(20000, PointDistribution::UNIFORM_DISK, 11);
+    std::vector<Point> expected = monotone_chain(points);
+
+    std::vector<size_t> allocations;
+    bool all_match = true;
+    for (int round = 0; round < 5; round++)
+    {
+        arena.reset();
+        {
+            std::pmr::vector<Point> hull = quick_hull(points, &arena);
+            std::pmr::vector<Line> lines = get_convex_hull_lines(hull, &arena);
+            std::pmr::vector<Point> in_place = quick_hull_in_place(std::pmr::vector<Point>(points.begin(), points.end(), &arena));
+            std::pmr::vector<Point> chain = monotone_chain(std::pmr::vector<Point>(points.begin(), points.end(), &arena));
+
+            all_match = all_match && std::equal(hull.begin(), hull.end(), expected.begin(), expected.end()) && lines.size() == expected.size();
+            all_match = all_match && std::equal(in_place.begin(), in_place.end(), expected.begin(), expected.end());
+            all_match = all_match && std::equal(chain.begin(), chain.end(), expected.begin(), expected.end());
+        }
+        allocations.push_back(counter.allocations());
+    }
+    IS_TRUE(all_match);
+    IS_TRUE(allocations[0] > 1);
+    // the second round merges the blocks of the first one, after which nothing reaches the heap
+    IS_EQUAL(allocations[4], allocations[1]);
+}
+
+void test_arena()
+{
+    test_counting_resource();
+
+    test_hull_arena_allocations();
+
+    test_repeated_hulls_reach_zero_heap_allocations();
+}
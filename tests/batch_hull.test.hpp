@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include "../tester.hpp"
+#include "../batch_hull.hpp"
+#include "../generator.hpp"
+
+void test_small_convex_hull_matches_monotone_chain()
+{
+    // every set of up to SMALL_HULL_SIZE points from a 3x3 grid, so duplicate and collinear points are common
+    bool all_match = true;
+    for (uint64_t seed = 0; seed < 2000; seed++)
+    {
+        size_t count = (size_t)(seed % (SMALL_HULL_SIZE + 1));
+        std::vector<Point> points;
+        for (size_t i = 0; i < count; i++)
+        {
+            points.push_back(Point((double)(random_bits(seed, i, 0) % 3), (double)(random_bits(seed, i, 1) % 3)));
+        }
+        Point hull[SMALL_HULL_SIZE];
+        size_t hull_size = small_convex_hull(points.data(), count, hull);
+        all_match = all_match && std::vector<Point>(hull, hull + hull_size) == monotone_chain(points);
+    }
+    IS_TRUE(all_match);
+}
+
+void test_batch_convex_hull_matches_monotone_chain()
+{
+    ThreadPool pool(4);
+    std::vector<Point> points;
+    std::vector<size_t> offsets = {0};
+    for (uint64_t i = 0; i < 3000; i++)
+    {
+        size_t count = (size_t)(random_bits(5, i, 0) % 200);
+        std::vector<Point> set = generate_points(count, i % 2 ? PointDistribution::UNIFORM_SQUARE : PointDistribution::DUPLICATES, i);
+        points.insert(points.end(), set.begin(), set.end());
+        offsets.push_back(points.size());
+    }
+
+    HullBatch hulls;
+    IS_TRUE(batch_convex_hull(points, offsets, hulls, pool, 16));
+    IS_EQUAL(hulls.size(), offsets.size() - 1);
+    IS_EQUAL(hulls.offsets.back(), hulls.points.size());
+    bool all_match = true;
+    for (size_t i = 0; i < hulls.size(); i++)
+    {
+        std::vector<Point> set(points.begin() + (ptrdiff_t)offsets[i], points.begin() + (ptrdiff_t)offsets[i + 1]);
+        std::vector<Point> hull(hulls[i].begin(), hulls[i].end());
+        all_match = all_match && hull == monotone_chain(set);
+    }
+    IS_TRUE(all_match);
+
+    // the hulls do not depend on how the sets are split between threads
+    HullBatch single;
+    ThreadPool one(1);
+    IS_TRUE(batch_convex_hull(points, offsets, single, one));
+    IS_TRUE(single.points == hulls.points && single.offsets == hulls.offsets);
+}
+
+void test_batch_convex_hull_invalid_offsets()
+{
+    std::vector<Point> points = {Point(0, 0), Point(1, 0), Point(0, 1)};
+    HullBatch hulls;
+    IS_FALSE(batch_convex_hull(points, std::vector<size_t>(), hulls));
+    IS_FALSE(batch_convex_hull(points, std::vector<size_t>{0, 2, 1, 3}, hulls));
+    IS_FALSE(batch_convex_hull(points, std::vector<size_t>{0, 4}, hulls));
+
+    IS_TRUE(batch_convex_hull(points, std::vector<size_t>{0}, hulls));
+    IS_EQUAL(hulls.size(), 0);
+    IS_TRUE(batch_convex_hull(points, std::vector<size_t>{1, 1, 3}, hulls));
+    IS_EQUAL(hulls.size(), 2);
+    IS_EQUAL(hulls[0].size(), 0);
+    IS_EQUAL(hulls[1].size(), 2);
+}
+
+void test_batch_hull()
+{
+    test_small_convex_hull_matches_monotone_chain();
+
+    test_batch_convex_hull_matches_monotone_chain();
+
+    test_batch_convex_hull_invalid_offsets();
+}
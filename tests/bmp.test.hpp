@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../tester.hpp"
+#include "../bmp.hpp"
+
+double **blank_image_array(uint64_t width, uint64_t height)
+{
+    double **image_array = new double *[height];
+    for (uint64_t i = 0; i < height; i++)
+    {
+        image_array[i] = new double[width]();
+    }
+    return image_array;
+}
+
+void free_image_array(double **image_array, uint64_t height)
+{
+    for (uint64_t i = 0; i < height; i++)
+    {
+        delete[] image_array[i];
+    }
+    delete[] image_array;
+}
+
+void test_bmp_headers_are_little_endian()
+{
+    uint8_t headers[BMP_HEADER_SIZE + DIB_HEADER_SIZE];
+    write_bmp_headers(headers, 5, 3);
+
+    IS_EQUAL(headers[0], 'B');
+    IS_EQUAL(headers[1], 'M');
+    // 5 pixels take 15 bytes, padded to 16
+    IS_EQUAL(calculate_row_size(5), 16);
+    IS_EQUAL((int)headers[2], 54 + 16 * 3);
+    IS_EQUAL((int)headers[10], 54);
+    IS_EQUAL((int)headers[BMP_HEADER_SIZE], 40);
+    IS_EQUAL((int)headers[BMP_HEADER_SIZE + 4], 5);
+    IS_EQUAL((int)headers[BMP_HEADER_SIZE + 8], 3);
+    IS_EQUAL((int)headers[BMP_HEADER_SIZE + 14], 24);
+    IS_EQUAL((int)headers[BMP_HEADER_SIZE + 20], 16 * 3);
+}
+
+void test_encode_bmp_matches_hex_encoding()
+{
+    // with 4 pixels per row there is no padding, so the old hex encoding gives the same file
+    double **image_array = blank_image_array(4, 3);
+    image_array[0][1] = 1;
+    image_array[2][3] = 2;
+
+    std::vector<uint8_t> buffer;
+    encode_bmp(image_array, 4, 3, buffer);
+    std::string binary = hex_string_to_binary_string(create_bitmap_hex_from_image_array(image_array, 4, 3));
+    IS_TRUE(std::string(buffer.begin(), buffer.end()) == binary);
+    free_image_array(image_array, 3);
+}
+
+void test_encode_bmp_pads_rows()
+{
+    double **image_array = blank_image_array(3, 2);
+    image_array[1][2] = 2;
+
+    std::vector<uint8_t> buffer;
+    encode_bmp(image_array, 3, 2, buffer);
+    IS_EQUAL(buffer.size(), calculate_file_size(3, 2));
+
+    // every row is 9 bytes of pixels and 3 bytes of padding
+    const uint8_t *second_row = buffer.data() + BMP_HEADER_SIZE + DIB_HEADER_SIZE + 12;
+    IS_EQUAL((int)second_row[6], 0);
+    IS_EQUAL((int)second_row[7], 0);
+    IS_EQUAL((int)second_row[8], 255);
+    IS_EQUAL((int)second_row[9], 0);
+    IS_EQUAL((int)second_row[11], 0);
+
+    // the file holds the same bytes as the buffer
+    const char *filename = "bmp_test.bmp";
+    IS_TRUE(create_bmp_file_from_image_array(image_array, 3, 2, filename));
+    FILE *file = fopen(filename, "rb");
+    std::vector<uint8_t> written(buffer.size() + 1);
+    IS_EQUAL(fread(written.data(), 1, written.size(), file), buffer.size());
+    fclose(file);
+    remove(filename);
+    written.resize(buffer.size());
+    IS_TRUE(written == buffer);
+    free_image_array(image_array, 2);
+}
+
+void test_bmp()
+{
+    test_bmp_headers_are_little_endian();
+
+    test_encode_bmp_matches_hex_encoding();
+
+    test_encode_bmp_pads_rows();
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include "../tester.hpp"
+#include "../calipers.hpp"
+#include "../convex_hull.hpp"
+#include "../generator.hpp"
+
+// the diameter, width and enclosing rectangles in O(h^2), by checking every pair of vertices and every edge
+double diameter_by_pairs(const std::vector<Point> &hull)
+{
+    double diameter = 0;
+    for (Point a : hull)
+    {
+        for (Point b : hull)
+        {
+            diameter = max(diameter, a.distance_to(b));
+        }
+    }
+    return diameter;
+}
+
+double width_by_edges(const std::vector<Point> &hull)
+{
+    double width = INFINITY;
+    for (size_t i = 0; i < hull.size(); i++)
+    {
+        Line edge(hull[i], hull[(i + 1) % hull.size()]);
+        double farthest = 0;
+        for (Point p : hull)
+        {
+            farthest = max(farthest, edge.distance_from_point(p));
+        }
+        width = min(width, farthest);
+    }
+    return width;
+}
+
+void rectangles_by_edges(const std::vector<Point> &hull, double &smallest_area, double &smallest_perimeter)
+{
+    smallest_area = smallest_perimeter = INFINITY;
+    for (size_t i = 0; i < hull.size(); i++)
+    {
+        Point a = hull[i], b = hull[(i + 1) % hull.size()];
+        double length = a.distance_to(b), ux = (b.get_x() - a.get_x()) / length, uy = (b.get_y() - a.get_y()) / length;
+        double low = INFINITY, high = -INFINITY, top = 0;
+        for (Point p : hull)
+        {
+            double along = ux * (p.get_x() - a.get_x()) + uy * (p.get_y() - a.get_y());
+            low = min(low, along);
+            high = max(high, along);
+            top = max(top, ux * (p.get_y() - a.get_y()) - uy * (p.get_x() - a.get_x()));
+        }
+        smallest_area = min(smallest_area, (high - low) * top);
+        smallest_perimeter = min(smallest_perimeter, 2 * (high - low + top));
+    }
+}
+
+bool nearly_equal(double a, double b)
+{
+    return std::abs(a - b) <= 1e-9 * max(1.0, max(std::abs(a), std::abs(b)));
+}
+
+void test_calipers_match_the_quadratic_loops()
+{
+    bool all_match = true;
+    for (uint64_t seed = 0; seed < 200; seed++)
+    {
+        PointDistribution distribution = seed % 3 == 0 ? PointDistribution::CIRCLE : seed % 3 == 1 ? PointDistribution::UNIFORM_SQUARE : PointDistribution::CLUSTERED;
+        std::vector<Point> hull = monotone_chain(generate_points(3 + seed * 5, distribution, seed));
+        if (hull.size() < 3)
+        {
+            continue;
+        }
+
+        PointPair diameter = hull_diameter(hull);
+        all_match = all_match && nearly_equal(diameter.distance(), diameter_by_pairs(hull));
+        all_match = all_match && diameter.squared_distance == squared_distance(diameter.first, diameter.second);
+        all_match = all_match && nearly_equal(hull_width(hull), width_by_edges(hull));
+
+        double smallest_area, smallest_perimeter;
+        rectangles_by_edges(hull, smallest_area, smallest_perimeter);
+        EnclosingRectangle by_area = minimum_area_rectangle(hull), by_perimeter = minimum_perimeter_rectangle(hull);
+        all_match = all_match && nearly_equal(by_area.area(), smallest_area) && nearly_equal(by_perimeter.perimeter(), smallest_perimeter);
+
+        // the rectangle encloses the hull, up to rounding, and its corners are counter-clockwise
+        for (size_t k = 0; k < 4; k++)
+        {
+            Point a = by_area.corners[k], b = by_area.corners[(k + 1) % 4];
+            all_match = all_match && cross_product(a, b, by_area.corners[(k + 2) % 4]) > 0;
+            for (Point p : hull)
+            {
+                all_match = all_match && cross_product(a, b, p) >= -1e-12;
+            }
+        }
+    }
+    IS_TRUE(all_match);
+}
+
+void test_calipers_on_simple_shapes()
+{
+    std::vector<Point> square = {Point(0, 0), Point(2, 0), Point(2, 2), Point(0, 2)};
+    IS_EQUAL(hull_diameter(square).squared_distance, 8);
+    IS_EQUAL(hull_width(square), 2);
+    EnclosingRectangle rectangle = minimum_area_rectangle(square);
+    IS_EQUAL(rectangle.area(), 4);
+    IS_EQUAL(rectangle.perimeter(), 8);
+    IS_TRUE(rectangle.corners[0] == Point(0, 0) && rectangle.corners[2] == Point(2, 2));
+
+    // a diamond is enclosed by a rotated square with half the area of its axis-aligned box
+    std::vector<Point> diamond = {Point(0, -1), Point(1, 0), Point(0, 1), Point(-1, 0)};
+    IS_TRUE(nearly_equal(minimum_area_rectangle(diamond).area(), 2));
+    IS_TRUE(nearly_equal(hull_width(diamond), sqrt(2.0)));
+    IS_EQUAL(hull_diameter(diamond).squared_distance, 4);
+
+    // a long thin triangle: the smallest area and the smallest perimeter are reached along different edges
+    std::vector<Point> triangle = {Point(0, 0), Point(10, 0), Point(9, 1)};
+    double smallest_area, smallest_perimeter;
+    rectangles_by_edges(triangle, smallest_area, smallest_perimeter);
+    IS_TRUE(nearly_equal(minimum_area_rectangle(triangle).area(), smallest_area));
+    IS_TRUE(nearly_equal(minimum_perimeter_rectangle(triangle).perimeter(), smallest_perimeter));
+
+    // degenerate hulls
+    IS_EQUAL(hull_diameter(std::vector<Point>{}).squared_distance, 0);
+    IS_EQUAL(hull_diameter(std::vector<Point>{Point(1, 1)}).squared_distance, 0);
+    IS_EQUAL(hull_diameter(std::vector<Point>{Point(0, 0), Point(3, 4)}).distance(), 5);
+    IS_EQUAL(hull_width(std::vector<Point>{Point(0, 0), Point(3, 4)}), 0);
+    EnclosingRectangle segment = minimum_perimeter_rectangle(std::vector<Point>{Point(0, 0), Point(3, 4)});
+    IS_EQUAL(segment.area(), 0);
+    IS_EQUAL(segment.perimeter(), 10);
+    IS_TRUE(minimum_area_rectangle(std::vector<Point>{Point(1, 1)}).corners[3] == Point(1, 1));
+}
+
+void test_calipers_batch()
+{
+    std::vector<Point> points;
+    std::vector<size_t> offsets = {0};
+    for (uint64_t i = 0; i < 500; i++)
+    {
+        std::vector<Point> set = generate_points((size_t)(random_bits(3, i, 0) % 100), PointDistribution::UNIFORM_DISK, i);
+        points.insert(points.end(), set.begin(), set.end());
+        offsets.push_back(points.size());
+    }
+    ThreadPool pool(4);
+    HullBatch hulls;
+    IS_TRUE(batch_convex_hull(points, offsets, hulls, pool));
+
+    vector<PointPair> diameters;
+    vector<double> widths;
+    vector<EnclosingRectangle> by_area, by_perimeter;
+    hull_diameters(hulls, diameters, pool, 16);
+    hull_widths(hulls, widths, pool, 16);
+    minimum_area_rectangles(hulls, by_area, pool, 16);
+    minimum_perimeter_rectangles(hulls, by_perimeter, pool, 16);
+    IS_EQUAL(diameters.size(), hulls.size());
+    IS_EQUAL(by_perimeter.size(), hulls.size());
+
+    bool all_match = true;
+    for (size_t i = 0; i < hulls.size(); i++)
+    {
+        all_match = all_match && diameters[i].squared_distance == hull_diameter(hulls[i]).squared_distance;
+        all_match = all_match && widths[i] == hull_width(hulls[i]);
+        all_match = all_match && by_area[i].area() == minimum_area_rectangle(hulls[i]).area();
+        all_match = all_match && by_perimeter[i].perimeter() == minimum_perimeter_rectangle(hulls[i]).perimeter();
+    }
+    IS_TRUE(all_match);
+}
+
+void test_calipers()
+{
+    test_calipers_match_the_quadratic_loops();
+
+    test_calipers_on_simple_shapes();
+
+    test_calipers_batch();
+}
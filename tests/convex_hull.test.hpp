@@ -0,0 +1,447 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include "../tester.hpp"
+#include "../convex_hull.hpp"
+
+// sorts the points of a hull so that hulls of different engines can be compared
+std::vector<Point> sorted_hull(std::vector<Point> hull)
+{
+    std::sort(hull.begin(), hull.end());
+    return hull;
+}
+
+std::vector<Point> square_with_interior_points()
+{
+    std::vector<Point> points = {Point(0.5, 0.5), Point(1, 1), Point(0, 1), Point(0.2, 0.7),
+                                 Point(1, 0), Point(0, 0), Point(0.9, 0.1), Point(0.3, 0.3)};
+    return points;
+}
+
+std::vector<Point> points_on_circle(uint64_t count)
+{
+    std::vector<Point> points;
+    for (uint64_t i = 0; i < count; i++)
+    {
+        double angle = 2 * M_PI * (double)i / (double)count;
+        points.push_back(Point(0.5 + 0.5 * cos(angle), 0.5 + 0.5 * sin(angle)));
+    }
+    return points;
+}
+
+void test_monotone_chain_counter_clockwise_order()
+{
+    std::vector<Point> hull = monotone_chain(square_with_interior_points());
+
+    IS_EQUAL(hull.size(), 4);
+    IS_EQUAL(hull[0], Point(0, 0));
+    IS_EQUAL(hull[1], Point(1, 0));
+    IS_EQUAL(hull[2], Point(1, 1));
+    IS_EQUAL(hull[3], Point(0, 1));
+}
+
+void test_monotone_chain_collinear_and_duplicate_points()
+{
+    std::vector<Point> collinear = {Point(0, 0), Point(2, 2), Point(1, 1), Point(2, 2)};
+    std::vector<Point> hull = monotone_chain(collinear);
+
+    IS_EQUAL(hull.size(), 2);
+    IS_EQUAL(hull[0], Point(0, 0));
+    IS_EQUAL(hull[1], Point(2, 2));
+
+    std::vector<Point> square = square_with_interior_points();
+    square.push_back(Point(0.5, 0));
+    square.push_back(Point(1, 1));
+    IS_EQUAL(monotone_chain(square).size(), 4);
+}
+
+void test_monotone_chain_matches_quick_hull()
+{
+    std::vector<Point> points = generate_random_data_points(200);
+
+    IS_TRUE(sorted_hull(monotone_chain(points)) == sorted_hull(quick_hull(points)));
+}
+
+void test_quick_hull_in_place_matches_quick_hull()
+{
+    std::vector<Point> points = generate_random_data_points(500);
+    std::vector<Point> hull = quick_hull_in_place(points);
+
+    IS_TRUE(sorted_hull(hull) == sorted_hull(quick_hull(points)));
+    IS_TRUE(sorted_hull(hull) == sorted_hull(monotone_chain(points)));
+}
+
+void test_quick_hull_in_place_order_and_degenerate_inputs()
+{
+    std::vector<Point> hull = quick_hull_in_place(square_with_interior_points());
+
+    IS_EQUAL(hull.size(), 4);
+    IS_EQUAL(hull[0], Point(0, 0));
+    IS_EQUAL(hull[1], Point(1, 0));
+    IS_EQUAL(hull[2], Point(1, 1));
+    IS_EQUAL(hull[3], Point(0, 1));
+
+    std::vector<Point> same = {Point(1, 1), Point(1, 1)};
+    IS_EQUAL(quick_hull_in_place(same).size(), 1);
+
+    std::vector<Point> collinear = {Point(1, 1), Point(0, 0), Point(2, 2)};
+    IS_EQUAL(quick_hull_in_place(collinear).size(), 2);
+
+    IS_EQUAL(quick_hull_in_place(points_on_circle(1000)).size(), 1000);
+}
+
+void test_quick_hull_parallel_matches_monotone_chain()
+{
+    ThreadPool pool(4);
+    std::vector<Point> points = generate_random_data_points(20000);
+    std::vector<Point> hull = quick_hull_parallel(points, pool, 64);
+
+    IS_TRUE(hull == quick_hull_in_place(points));
+
+    std::vector<Point> circle = points_on_circle(5000);
+    IS_TRUE(quick_hull_parallel(circle, pool, 64) == monotone_chain(circle));
+}
+
+void test_task_group_rethrows_task_exceptions()
+{
+    ThreadPool pool(2);
+    TaskGroup group(pool);
+    std::atomic<size_t> done(0);
+    for (size_t i = 0; i < 8; i++)
+    {
+        group.run([i, &done]
+                  {
+            if (i == 3)
+            {
+                throw std::runtime_error("task failed");
+            }
+            done++; });
+    }
+    bool thrown = false;
+    try
+    {
+        group.wait();
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    IS_TRUE(thrown);
+    IS_EQUAL(done.load(), 7);
+
+    // the exception is only rethrown once
+    group.run([&done]
+              { done++; });
+    group.wait();
+    IS_EQUAL(done.load(), 8);
+}
+
+void test_quick_hull_soa_matches_quick_hull_in_place()
+{
+    std::vector<Point> points = generate_random_data_points(3000);
+
+    IS_TRUE(quick_hull_soa(PointBuffer(points)) == quick_hull_in_place(points));
+
+    std::vector<Point> circle = points_on_circle(2000);
+    IS_TRUE(quick_hull_soa(PointBuffer(circle)) == monotone_chain(circle));
+    IS_TRUE(quick_hull_soa(PointBuffer(square_with_interior_points())) == monotone_chain(square_with_interior_points()));
+}
+
+void test_octagon_boundary_is_not_inside()
+{
+    // p is on the right of a->b by 1.7e-17, but the rounded cross product is 1.1e-16
+    Point a(0.57490566421198, 0.043574618551851296), b(1.8149486765188296, 1.651117045683278), c(0, 2);
+    Point p(0.9638453678007107, 0.5477805766594483);
+    IS_TRUE(cross_product(a, b, p) > 0);
+    IS_TRUE(orient2d(a, b, p) < 0);
+
+    Octagon octagon;
+    octagon.vertices = {a, a, a, b, b, b, c, c};
+    octagon.build_edges();
+    IS_EQUAL(octagon.edge_count, 3);
+    IS_FALSE(octagon.strictly_contains(p.get_x(), p.get_y()));
+    IS_FALSE(octagon.strictly_contains(a.get_x(), a.get_y()));
+    IS_TRUE(octagon.strictly_contains(0.8, 1.0));
+    IS_FALSE(octagon.strictly_contains(2, 0));
+}
+
+void test_akl_toussaint_filter()
+{
+    ThreadPool pool(3);
+    std::vector<Point> points = generate_random_data_points(10000);
+    std::vector<Point> filtered = points;
+    size_t survivors = akl_toussaint_filter(filtered, pool, 100);
+
+    IS_EQUAL(survivors, filtered.size());
+    IS_TRUE(survivors < points.size() / 2);
+    IS_TRUE(monotone_chain(filtered) == monotone_chain(points));
+
+    PointBuffer buffer(points);
+    IS_EQUAL(akl_toussaint_filter(buffer, pool, 100), survivors);
+    IS_TRUE(buffer.to_vector() == filtered);
+
+    // every point of a circle is on the hull
+    std::vector<Point> circle = points_on_circle(1000);
+    IS_EQUAL(akl_toussaint_filter(circle, pool, 100), 1000);
+}
+
+void test_convex_hull_with_prefilter()
+{
+    std::vector<Point> points = generate_random_data_points(5000);
+    size_t survivors = 0;
+    HullOptions options;
+    options.prefilter = true;
+    options.survivors = &survivors;
+
+    IS_TRUE(convex_hull(points, options) == monotone_chain(points));
+    IS_TRUE(survivors > 0 && survivors < points.size());
+
+    options.algorithm = Algorithm::QUICK_HULL;
+    IS_TRUE(convex_hull(points, options) == monotone_chain(points));
+}
+
+void test_tangent_to_polygon()
+{
+    std::vector<Point> square = {Point(0, 0), Point(1, 0), Point(1, 1), Point(0, 1)};
+
+    IS_EQUAL(tangent_to_polygon(Point(2, 0.5), square.data(), 4), 2);
+    IS_EQUAL(tangent_to_polygon(Point(-1, 0.5), square.data(), 4), 0);
+    IS_EQUAL(tangent_to_polygon(Point(0.5, 3), square.data(), 4), 3);
+}
+
+void test_chan_matches_monotone_chain()
+{
+    std::vector<Point> points = generate_random_data_points(5000);
+    IS_TRUE(chan(points) == monotone_chain(points));
+
+    std::vector<Point> circle = points_on_circle(300);
+    IS_TRUE(chan(circle) == monotone_chain(circle));
+
+    std::vector<Point> square = square_with_interior_points();
+    square.push_back(Point(0.5, 0));
+    square.push_back(Point(0, 0));
+    square.push_back(Point(1, 1));
+    IS_TRUE(chan(square) == monotone_chain(square));
+
+    std::vector<Point> collinear = {Point(1, 1), Point(0, 0), Point(2, 2), Point(3, 3), Point(0, 0)};
+    IS_TRUE(chan(collinear) == monotone_chain(collinear));
+
+    std::vector<Point> grid;
+    for (int i = 0; i < 30; i++)
+    {
+        for (int j = 0; j < 30; j++)
+        {
+            grid.push_back(Point(i % 7, j % 5));
+        }
+    }
+    IS_TRUE(chan(grid) == monotone_chain(grid));
+    IS_TRUE(convex_hull(grid, Algorithm::CHAN) == monotone_chain(grid));
+}
+
+void test_estimate_hull_size()
+{
+    std::vector<Point> circle = points_on_circle(4096);
+    std::vector<Point> square = generate_random_data_points(4096);
+
+    IS_TRUE(estimate_hull_size(circle) > 2048);
+    IS_TRUE(estimate_hull_size(square) < 256);
+}
+
+void test_convex_hull_dispatch()
+{
+    std::vector<Point> square = square_with_interior_points();
+    std::vector<Point> expected = sorted_hull(monotone_chain(square));
+
+    IS_TRUE(sorted_hull(convex_hull(square)) == expected);
+    IS_TRUE(sorted_hull(convex_hull(square, Algorithm::QUICK_HULL)) == expected);
+    IS_TRUE(sorted_hull(convex_hull(square, Algorithm::MONOTONE_CHAIN)) == expected);
+
+    std::vector<Point> circle = points_on_circle(1000);
+    IS_EQUAL(convex_hull(circle).size(), 1000);
+}
+
+void test_every_engine_returns_the_same_ordered_hull()
+{
+    ThreadPool pool(2);
+    std::vector<Point> grid;
+    for (int i = 0; i < 12; i++)
+    {
+        for (int j = 0; j < 9; j++)
+        {
+            grid.push_back(Point((i * 5) % 12, (j * 4) % 9));
+        }
+    }
+    std::vector<Point> random = generate_random_data_points(2000);
+
+    for (const std::vector<Point> &points : {grid, random, square_with_interior_points()})
+    {
+        std::vector<Point> expected = monotone_chain(points);
+        IS_TRUE(gift_wrapping(points) == expected);
+        IS_TRUE(quick_hull(points) == expected);
+        IS_TRUE(quick_hull_in_place(points) == expected);
+        IS_TRUE(quick_hull_soa(PointBuffer(points)) == expected);
+        IS_TRUE(quick_hull_parallel(points, pool, 16) == expected);
+        IS_TRUE(chan(points) == expected);
+    }
+
+    std::vector<Point> same = {Point(2, 3), Point(2, 3)};
+    IS_EQUAL(gift_wrapping(same).size(), 1);
+    IS_EQUAL(quick_hull(same).size(), 1);
+}
+
+void test_every_engine_agrees_on_nearly_collinear_points()
+{
+    ThreadPool pool(2);
+    std::vector<Point> points;
+    // points on a line, moved off it by a few ulps, where a floating point cross product has the wrong sign
+    for (int i = 0; i < 200; i++)
+    {
+        double x = random_unit(7, (uint64_t)i, 0), y = 1.7 * x + 0.1;
+        for (int k = 0; k < i % 7; k++)
+        {
+            y = std::nextafter(y, i % 2 ? 10.0 : -10.0);
+        }
+        points.push_back(Point(x, y));
+    }
+
+    std::vector<Point> expected = monotone_chain(points);
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        IS_TRUE(orient2d(expected[i], expected[(i + 1) % expected.size()], expected[(i + 2) % expected.size()]) > 0);
+    }
+    IS_TRUE(gift_wrapping(points) == expected);
+    IS_TRUE(quick_hull(points) == expected);
+    IS_TRUE(quick_hull_in_place(points) == expected);
+    IS_TRUE(quick_hull_soa(PointBuffer(points)) == expected);
+    IS_TRUE(quick_hull_parallel(points, pool, 16) == expected);
+    IS_TRUE(chan(points) == expected);
+}
+
+void test_integer_engines_are_exact()
+{
+    // small coordinates are exact as doubles too, so both paths must find the same hull
+    std::vector<IntPoint> points;
+    std::vector<Point> doubles;
+    for (uint64_t i = 0; i < 2000; i++)
+    {
+        IntPoint p = IntPoint((int32_t)(random_bits(3, i, 0) % 1000), (int32_t)(random_bits(3, i, 1) % 1000));
+        points.push_back(p);
+        doubles.push_back(Point(p.get_x(), p.get_y()));
+    }
+    std::vector<IntPoint> expected = monotone_chain(points);
+    std::vector<Point> expected_doubles = monotone_chain(doubles);
+    IS_EQUAL(expected.size(), expected_doubles.size());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        IS_TRUE(Point(expected[i].get_x(), expected[i].get_y()) == expected_doubles[i]);
+    }
+    IS_TRUE(gift_wrapping(points) == expected);
+    IS_TRUE(quick_hull_in_place(points) == expected);
+    IS_TRUE(convex_hull(points) == expected);
+
+    // points a unit away from a long line across the whole grid, which doubles cannot tell apart from the line
+    std::vector<IntPoint> wide = {IntPoint(INT32_MIN, INT32_MIN), IntPoint(INT32_MAX, INT32_MAX)};
+    for (int32_t i = 1; i < 200; i++)
+    {
+        int32_t x = (int32_t)((int64_t)INT32_MIN + (int64_t)i * 21474836);
+        wide.push_back(IntPoint(x, x + (i % 3) - 1));
+    }
+    expected = monotone_chain(wide);
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        IS_TRUE(orient2d(expected[i], expected[(i + 1) % expected.size()], expected[(i + 2) % expected.size()]) > 0);
+    }
+    IS_TRUE(gift_wrapping(wide) == expected);
+    IS_TRUE(quick_hull_in_place(wide) == expected);
+    IS_TRUE(convex_hull(wide, Algorithm::QUICK_HULL) == expected);
+}
+
+void test_convex_hull_keeps_collinear_points()
+{
+    std::vector<Point> points = square_with_interior_points();
+    points.push_back(Point(0.5, 0));
+    points.push_back(Point(0.25, 0));
+    points.push_back(Point(1, 0.5));
+    points.push_back(Point(0, 0.5));
+    points.push_back(Point(0.5, 0));
+    HullOptions options;
+    options.keep_collinear = true;
+
+    std::vector<Point> expected = {Point(0, 0), Point(0.25, 0), Point(0.5, 0), Point(1, 0), Point(1, 0.5), Point(1, 1), Point(0, 1), Point(0, 0.5)};
+    IS_TRUE(convex_hull(points, options) == expected);
+    options.algorithm = Algorithm::GIFT_WRAPPING;
+    IS_TRUE(convex_hull(points, options) == expected);
+
+    std::vector<Point> segment = {Point(2, 2), Point(0, 0), Point(1, 1), Point(3, 3)};
+    std::vector<Point> expected_segment = {Point(0, 0), Point(1, 1), Point(2, 2), Point(3, 3)};
+    IS_TRUE(convex_hull(segment, options) == expected_segment);
+}
+
+void test_hull_edges()
+{
+    std::vector<Point> hull = monotone_chain(square_with_interior_points());
+    HullEdges edges = hull_edges(hull);
+
+    IS_EQUAL(edges.size(), 4);
+    size_t i = 0;
+    for (Line edge : edges)
+    {
+        IS_EQUAL(edge.get_start(), hull[i]);
+        IS_EQUAL(edge.get_end(), hull[(i + 1) % 4]);
+        i++;
+    }
+    IS_EQUAL(i, 4);
+    IS_EQUAL(get_convex_hull_lines(hull).size(), 4);
+
+    std::vector<Point> segment = {Point(0, 0), Point(1, 1)};
+    IS_EQUAL(hull_edges(segment).size(), 1);
+    std::vector<Point> single = {Point(0, 0)};
+    IS_EQUAL(hull_edges(single).size(), 0);
+}
+
+void test_convex_hull()
+{
+    test_monotone_chain_counter_clockwise_order();
+
+    test_monotone_chain_collinear_and_duplicate_points();
+
+    test_monotone_chain_matches_quick_hull();
+
+    test_quick_hull_in_place_matches_quick_hull();
+
+    test_quick_hull_in_place_order_and_degenerate_inputs();
+
+    test_quick_hull_parallel_matches_monotone_chain();
+
+    test_task_group_rethrows_task_exceptions();
+
+    test_quick_hull_soa_matches_quick_hull_in_place();
+
+    test_akl_toussaint_filter();
+
+    test_octagon_boundary_is_not_inside();
+
+    test_convex_hull_with_prefilter();
+
+    test_tangent_to_polygon();
+
+    test_chan_matches_monotone_chain();
+
+    test_estimate_hull_size();
+
+    test_convex_hull_dispatch();
+
+    test_every_engine_returns_the_same_ordered_hull();
+
+    test_every_engine_agrees_on_nearly_collinear_points();
+
+    test_integer_engines_are_exact();
+
+    test_convex_hull_keeps_collinear_points();
+
+    test_hull_edges();
+}
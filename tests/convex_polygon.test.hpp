@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include "../tester.hpp"
+#include "../convex_polygon.hpp"
+#include "../generator.hpp"
+
+// clips a polygon by every edge of a convex polygon in O(nm), with Sutherland-Hodgman
+std::vector<Point> clip_by_edges(std::vector<Point> subject, const std::vector<Point> &clip)
+{
+    for (size_t i = 0; i < clip.size() && !subject.empty(); i++)
+    {
+        Point c = clip[i], d = clip[(i + 1) % clip.size()];
+        std::vector<Point> input = subject;
+        subject.clear();
+        for (size_t k = 0; k < input.size(); k++)
+        {
+            Point previous = input[(k + input.size() - 1) % input.size()], current = input[k];
+            double previous_side = orient2d(c, d, previous), current_side = orient2d(c, d, current);
+            if ((previous_side < 0) != (current_side < 0))
+            {
+                double t = previous_side / (previous_side - current_side);
+                subject.push_back(Point(previous.get_x() + t * (current.get_x() - previous.get_x()), previous.get_y() + t * (current.get_y() - previous.get_y())));
+            }
+            if (current_side >= 0)
+            {
+                subject.push_back(current);
+            }
+        }
+    }
+    return subject;
+}
+
+// random convex polygons, on a small grid so that they often share vertices and edges, or with real coordinates
+std::vector<Point> random_convex_polygon(uint64_t seed, bool on_grid)
+{
+    std::vector<Point> points;
+    size_t count = 3 + (size_t)(random_bits(seed, 0, 2) % 12);
+    double x_offset = random_unit(seed, 0, 3), y_offset = random_unit(seed, 1, 3);
+    for (size_t i = 0; i < count; i++)
+    {
+        if (on_grid)
+        {
+            points.push_back(Point((double)(random_bits(seed, i, 0) % 9), (double)(random_bits(seed, i, 1) % 9)));
+        }
+        else
+        {
+            points.push_back(Point(random_unit(seed, i, 0) + x_offset, random_unit(seed, i, 1) + y_offset));
+        }
+    }
+    return monotone_chain(points);
+}
+
+bool is_normalized(const std::vector<Point> &polygon)
+{
+    std::vector<Point> normalized = polygon;
+    normalize_convex_polygon(normalized);
+    return normalized == polygon;
+}
+
+void test_convex_intersection_matches_clipping()
+{
+    bool all_match = true, all_inside = true, all_normalized = true;
+    size_t empty_count = 0, area_count = 0;
+    for (uint64_t seed = 0; seed < 4000; seed++)
+    {
+        bool on_grid = seed % 2 == 0;
+        std::vector<Point> a = random_convex_polygon(2 * seed, on_grid), b = random_convex_polygon(2 * seed + 1, on_grid);
+        std::vector<Point> intersection = convex_intersection(a, b);
+        double expected = polygon_area(clip_by_edges(a, b));
+        double area = intersection.size() < 3 ? 0 : polygon_area(intersection);
+        all_match = all_match && std::abs(area - expected) <= 1e-9 * max(1.0, expected);
+        all_normalized = all_normalized && is_normalized(intersection);
+        for (Point p : intersection)
+        {
+            for (const std::vector<Point> *polygon : {&a, &b})
+            {
+                for (size_t i = 0; i < polygon->size(); i++)
+                {
+                    all_inside = all_inside && cross_product((*polygon)[i], (*polygon)[(i + 1) % polygon->size()], p) >= -1e-9;
+                }
+            }
+        }
+        empty_count += intersection.empty();
+        area_count += area > 0;
+    }
+    IS_TRUE(all_match);
+    IS_TRUE(all_inside);
+    IS_TRUE(all_normalized);
+    IS_TRUE(empty_count > 0 && area_count > 0);
+}
+
+void test_convex_intersection_special_cases()
+{
+    std::vector<Point> square = {Point(0, 0), Point(4, 0), Point(4, 4), Point(0, 4)};
+    std::vector<Point> inner = {Point(1, 1), Point(2, 1), Point(1, 2)};
+    IS_TRUE(convex_intersection(square, square) == square);
+    IS_TRUE(convex_intersection(square, inner) == inner);
+    IS_TRUE(convex_intersection(inner, square) == inner);
+
+    // touching at a corner, along an edge from outside, and disjoint
+    std::vector<Point> corner = {Point(4, 4), Point(6, 4), Point(6, 6)};
+    IS_TRUE(convex_intersection(square, corner) == std::vector<Point>{Point(4, 4)});
+    std::vector<Point> beside = {Point(4, 1), Point(8, 1), Point(8, 6), Point(4, 6)};
+    IS_TRUE(convex_intersection(square, beside) == (std::vector<Point>{Point(4, 1), Point(4, 4)}));
+    std::vector<Point> far = {Point(5, 0), Point(6, 0), Point(6, 1)};
+    IS_TRUE(convex_intersection(square, far).empty());
+
+    // overlapping with shared edges
+    std::vector<Point> shifted = {Point(2, 0), Point(6, 0), Point(6, 4), Point(2, 4)};
+    IS_TRUE(convex_intersection(square, shifted) == (std::vector<Point>{Point(2, 0), Point(4, 0), Point(4, 4), Point(2, 4)}));
+
+    // a star of David: the intersection is a hexagon
+    std::vector<Point> up = {Point(0, 0), Point(6, 0), Point(3, 6)}, down = {Point(0, 4), Point(3, -2), Point(6, 4)};
+    IS_EQUAL(convex_intersection(up, down).size(), 6);
+
+    // points and segments
+    std::vector<Point> empty, point = {Point(2, 2)}, segment = {Point(-2, 2), Point(6, 2)};
+    IS_TRUE(convex_intersection(square, empty).empty());
+    IS_TRUE(convex_intersection(point, square) == point);
+    IS_TRUE(convex_intersection(square, std::vector<Point>{Point(5, 5)}).empty());
+    IS_TRUE(convex_intersection(segment, square) == (std::vector<Point>{Point(0, 2), Point(4, 2)}));
+    IS_TRUE(convex_intersection(segment, point) == point);
+    IS_TRUE(convex_intersection(segment, std::vector<Point>{Point(2, 0), Point(2, 4)}) == point);
+    IS_TRUE(convex_intersection(segment, std::vector<Point>{Point(4, 2), Point(9, 2)}) == (std::vector<Point>{Point(4, 2), Point(6, 2)}));
+    IS_TRUE(convex_intersection(segment, std::vector<Point>{Point(0, 3), Point(4, 3)}).empty());
+}
+
+void test_minkowski_sum_matches_pairwise_sums()
+{
+    bool all_match = true;
+    for (uint64_t seed = 0; seed < 2000; seed++)
+    {
+        std::vector<Point> a = random_convex_polygon(2 * seed, seed % 2 == 0), b = random_convex_polygon(2 * seed + 1, seed % 2 == 0);
+        // also points and segments
+        if (seed % 7 == 0)
+        {
+            a.resize(1 + seed % 2);
+        }
+        std::vector<Point> sums;
+        for (Point p : a)
+        {
+            for (Point q : b)
+            {
+                sums.push_back(Point(p.get_x() + q.get_x(), p.get_y() + q.get_y()));
+            }
+        }
+        all_match = all_match && minkowski_sum(a, b) == monotone_chain(sums);
+    }
+    IS_TRUE(all_match);
+
+    std::vector<Point> segment = {Point(0, 0), Point(2, 0)}, vertical = {Point(0, 0), Point(0, 3)};
+    IS_TRUE(minkowski_sum(segment, vertical) == (std::vector<Point>{Point(0, 0), Point(2, 0), Point(2, 3), Point(0, 3)}));
+    IS_TRUE(minkowski_sum(segment, segment) == (std::vector<Point>{Point(0, 0), Point(4, 0)}));
+    IS_TRUE(minkowski_sum(std::vector<Point>{Point(1, 1)}, std::vector<Point>{Point(2, 3)}) == std::vector<Point>{Point(3, 4)});
+    IS_TRUE(minkowski_sum(std::vector<Point>{}, segment).empty());
+}
+
+void test_pairwise_polygon_batches()
+{
+    HullBatch first, second;
+    first.offsets = second.offsets = {0};
+    for (uint64_t i = 0; i < 700; i++)
+    {
+        std::vector<Point> a = random_convex_polygon(2 * i, i % 3 == 0), b = random_convex_polygon(2 * i + 1, i % 3 == 0);
+        a.resize(i % 50 == 0 ? i % 3 : a.size());
+        first.points.insert(first.points.end(), a.begin(), a.end());
+        first.offsets.push_back(first.points.size());
+        second.points.insert(second.points.end(), b.begin(), b.end());
+        second.offsets.push_back(second.points.size());
+    }
+
+    ThreadPool pool(4);
+    HullBatch intersections, sums;
+    IS_TRUE(convex_intersections(first, second, intersections, pool, 16));
+    IS_TRUE(minkowski_sums(first, second, sums, pool, 16));
+    IS_EQUAL(intersections.size(), first.size());
+    IS_EQUAL(sums.size(), first.size());
+    bool all_match = true;
+    for (size_t i = 0; i < first.size(); i++)
+    {
+        std::vector<Point> intersection(intersections[i].begin(), intersections[i].end()), sum(sums[i].begin(), sums[i].end());
+        all_match = all_match && intersection == convex_intersection(first[i], second[i]);
+        all_match = all_match && sum == minkowski_sum(first[i], second[i]);
+    }
+    IS_TRUE(all_match);
+
+    // the output buffers are reused
+    const Point *buffer = intersections.points.data();
+    IS_TRUE(convex_intersections(first, second, intersections, pool, 16));
+    IS_TRUE(intersections.points.data() == buffer);
+
+    second.offsets.pop_back();
+    IS_FALSE(convex_intersections(first, second, intersections));
+    IS_FALSE(minkowski_sums(first, second, sums));
+
+    // default-constructed batches hold no polygons and have no offsets
+    HullBatch empty, other_empty, with_offset;
+    with_offset.offsets = {0};
+    IS_TRUE(convex_intersections(empty, other_empty, intersections));
+    IS_EQUAL(intersections.size(), 0);
+    IS_TRUE(intersections.offsets == std::vector<size_t>{0});
+    IS_TRUE(minkowski_sums(empty, other_empty, sums));
+    IS_EQUAL(sums.size(), 0);
+    IS_TRUE(sums.points.empty());
+    IS_TRUE(convex_intersections(empty, with_offset, intersections));
+    IS_TRUE(minkowski_sums(with_offset, empty, sums));
+    IS_EQUAL(sums.size(), 0);
+}
+
+void test_convex_polygon()
+{
+    test_convex_intersection_matches_clipping();
+
+    test_convex_intersection_special_cases();
+
+    test_minkowski_sum_matches_pairwise_sums();
+
+    test_pairwise_polygon_batches();
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+#include "../tester.hpp"
+#include "../utils.hpp"
+#include "../convex_hull.hpp"
+#include "../dynamic_hull.hpp"
+
+void test_dynamic_hull_insert_and_erase()
+{
+    DynamicHull hull;
+    for (Point p : square_with_interior_points())
+    {
+        IS_TRUE(hull.insert(p));
+    }
+    IS_FALSE(hull.insert(Point(1, 1)));
+    IS_EQUAL(hull.size(), 8);
+    IS_TRUE(hull.contains(Point(0.3, 0.3)));
+
+    std::vector<Point> square = {Point(0, 0), Point(1, 0), Point(1, 1), Point(0, 1)};
+    IS_TRUE(hull.hull() == square);
+
+    // removing a corner exposes the interior points behind it
+    IS_TRUE(hull.erase(Point(1, 0)));
+    IS_FALSE(hull.erase(Point(1, 0)));
+    IS_FALSE(hull.contains(Point(1, 0)));
+    std::vector<Point> without_corner = {Point(0, 0), Point(0.9, 0.1), Point(1, 1), Point(0, 1)};
+    IS_TRUE(hull.hull() == without_corner);
+
+    IS_TRUE(hull.insert(Point(1, 0)));
+    IS_TRUE(hull.hull() == square);
+}
+
+void test_dynamic_hull_degenerate_hulls()
+{
+    DynamicHull hull;
+    IS_TRUE(hull.hull().empty());
+
+    hull.insert(Point(1, 1));
+    IS_EQUAL(hull.hull().size(), 1);
+
+    hull.insert(Point(3, 3));
+    hull.insert(Point(2, 2));
+    std::vector<Point> segment = {Point(1, 1), Point(3, 3)};
+    IS_TRUE(hull.hull() == segment);
+
+    hull.erase(Point(1, 1));
+    hull.erase(Point(3, 3));
+    hull.erase(Point(2, 2));
+    IS_TRUE(hull.empty());
+    IS_TRUE(hull.hull().empty());
+
+    std::vector<Point> column = {Point(0, 0), Point(0, 2), Point(0, 1), Point(1, 0), Point(1, 1), Point(1, 2)};
+    for (Point p : column)
+    {
+        hull.insert(p);
+    }
+    std::vector<Point> rectangle = {Point(0, 0), Point(1, 0), Point(1, 2), Point(0, 2)};
+    IS_TRUE(hull.hull() == rectangle);
+}
+
+void test_dynamic_hull_sliding_window_matches_monotone_chain()
+{
+    std::vector<Point> points = generate_random_data_points(3000);
+    const size_t window = 500;
+    DynamicHull hull;
+    bool all_match = true;
+
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        hull.insert(points[i]);
+        if (i >= window)
+        {
+            hull.erase(points[i - window]);
+        }
+        if (i % 89 == 0)
+        {
+            size_t first = i >= window ? i - window + 1 : 0;
+            std::vector<Point> alive(points.begin() + (long)first, points.begin() + (long)i + 1);
+            all_match = all_match && hull.hull() == monotone_chain(alive);
+        }
+    }
+    IS_TRUE(all_match);
+    IS_TRUE(DynamicHull(points).hull() == monotone_chain(points));
+}
+
+void test_dynamic_hull()
+{
+    test_dynamic_hull_insert_and_erase();
+
+    test_dynamic_hull_degenerate_hulls();
+
+    test_dynamic_hull_sliding_window_matches_monotone_chain();
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "../tester.hpp"
+#include "../bmp.hpp"
+#include "../framebuffer.hpp"
+#include "../visualizer.hpp"
+
+void test_framebuffer_is_contiguous_and_aligned()
+{
+    Framebuffer framebuffer(7, 5);
+    IS_EQUAL(framebuffer.get_width(), 7);
+    IS_EQUAL(framebuffer.get_height(), 5);
+    IS_EQUAL((uintptr_t)framebuffer.row(0) % FRAMEBUFFER_ALIGNMENT, 0);
+    IS_TRUE(framebuffer.row(4) == framebuffer.row(0) + 4 * 7);
+    IS_EQUAL((int)framebuffer.get(6, 4), BACKGROUND_COLOR);
+
+    framebuffer.set(6, 4, LINE_COLOR);
+    Framebuffer copy = framebuffer;
+    framebuffer.clear();
+    IS_EQUAL((int)copy.get(6, 4), LINE_COLOR);
+    IS_EQUAL((int)framebuffer.get(6, 4), BACKGROUND_COLOR);
+}
+
+void test_steep_lines_have_no_gaps()
+{
+    Framebuffer framebuffer(20, 50);
+    framebuffer.draw_line(2, 1, 7, 45, 0, LINE_COLOR);
+
+    // one pixel per row, each one next to the one below it
+    int64_t previous_x = -1;
+    for (uint64_t y = 1; y <= 45; y++)
+    {
+        int64_t count = 0, x_on_row = -1;
+        for (uint64_t x = 0; x < 20; x++)
+        {
+            if (framebuffer.get(x, y) == LINE_COLOR)
+            {
+                count++;
+                x_on_row = (int64_t)x;
+            }
+        }
+        IS_EQUAL(count, 1);
+        IS_TRUE(previous_x == -1 || (x_on_row - previous_x >= 0 && x_on_row - previous_x <= 1));
+        previous_x = x_on_row;
+    }
+    IS_EQUAL((int)framebuffer.get(2, 1), LINE_COLOR);
+    IS_EQUAL((int)framebuffer.get(7, 45), LINE_COLOR);
+    IS_EQUAL((int)framebuffer.get(2, 0), BACKGROUND_COLOR);
+    IS_EQUAL((int)framebuffer.get(7, 46), BACKGROUND_COLOR);
+}
+
+void test_drawing_is_clipped_to_the_image()
+{
+    Framebuffer framebuffer(10, 10);
+    framebuffer.stamp(0, 9, 2, POINT_COLOR);
+    IS_EQUAL((int)framebuffer.get(0, 9), POINT_COLOR);
+    IS_EQUAL((int)framebuffer.get(2, 7), POINT_COLOR);
+    IS_EQUAL((int)framebuffer.get(3, 9), BACKGROUND_COLOR);
+
+    // a line crossing the whole image from outside of it
+    framebuffer.draw_line(-5, 5, 15, 5, 0, LINE_COLOR);
+    for (uint64_t x = 0; x < 10; x++)
+    {
+        IS_EQUAL((int)framebuffer.get(x, 5), LINE_COLOR);
+    }
+
+    // lines reaching far outside the image only walk the part of them inside it
+    Framebuffer far(10, 10);
+    far.draw_line(-4000000000, 2, 4000000000, 2, 0, LINE_COLOR);
+    far.draw_line(3000000000, -1, -3000000000, -1, 1, LINE_COLOR);
+    far.draw_line(-3000000000, 20, 3000000000, 30, 2, LINE_COLOR);
+    far.draw_line(-1000000000, -1000000000, 1000000000, 1000000000, 0, POINT_COLOR);
+    for (uint64_t x = 0; x < 10; x++)
+    {
+        IS_EQUAL((int)far.get(x, x), POINT_COLOR);
+        IS_EQUAL((int)far.get(x, 0), (x == 0 ? POINT_COLOR : LINE_COLOR));
+        IS_EQUAL((int)far.get(x, 1), (x == 1 ? POINT_COLOR : BACKGROUND_COLOR));
+        IS_EQUAL((int)far.get(x, 2), (x == 2 ? POINT_COLOR : LINE_COLOR));
+        IS_EQUAL((int)far.get(x, 9), (x == 9 ? POINT_COLOR : BACKGROUND_COLOR));
+    }
+
+    // points slightly outside the unit square are clipped instead of wrapping around
+    Framebuffer unit(16, 16);
+    add_point_to_framebuffer(unit, Point(-0.5, 1.4));
+    add_line_to_framebuffer(unit, Line(Point(-0.5, 0.5), Point(1.5, 0.5)));
+    IS_EQUAL((int)unit.get(0, 15), POINT_COLOR);
+    IS_EQUAL((int)unit.get(15, 8), LINE_COLOR);
+}
+
+void test_framebuffer_bmp_matches_image_array_bmp()
+{
+    // the image arrays use the same codes as the default palette, indexed [row][column]
+    Framebuffer framebuffer(5, 3);
+    double **image_array = new double *[3];
+    for (uint64_t i = 0; i < 3; i++)
+    {
+        image_array[i] = new double[5]();
+    }
+    framebuffer.set(1, 0, POINT_COLOR);
+    image_array[0][1] = 1;
+    framebuffer.set(4, 2, LINE_COLOR);
+    image_array[2][4] = 2;
+
+    std::vector<uint8_t> from_framebuffer, from_image_array;
+    encode_bmp(framebuffer, from_framebuffer);
+    encode_bmp(image_array, 5, 3, from_image_array);
+    IS_TRUE(from_framebuffer == from_image_array);
+
+    // a changed palette entry changes every pixel using it
+    framebuffer.set_color(BACKGROUND_COLOR, Color{0, 128, 0});
+    encode_bmp(framebuffer, from_framebuffer);
+    IS_EQUAL((int)from_framebuffer[BMP_HEADER_SIZE + DIB_HEADER_SIZE + 1], 128);
+
+    for (uint64_t i = 0; i < 3; i++)
+    {
+        delete[] image_array[i];
+    }
+    delete[] image_array;
+}
+
+void test_framebuffer()
+{
+    test_framebuffer_is_contiguous_and_aligned();
+    test_steep_lines_have_no_gaps();
+    test_drawing_is_clipped_to_the_image();
+    test_framebuffer_bmp_matches_image_array_bmp();
+}
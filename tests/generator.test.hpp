@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "../tester.hpp"
+#include "../generator.hpp"
+#include "../convex_hull.hpp"
+
+void test_generator_is_reproducible()
+{
+    std::vector<Point> points = generate_points(10000, PointDistribution::CLUSTERED, 42);
+    IS_TRUE(generate_points(10000, PointDistribution::CLUSTERED, 42) == points);
+    IS_TRUE(generate_points(10000, PointDistribution::CLUSTERED, 43) != points);
+
+    // the set does not depend on how it is split between threads
+    ThreadPool single(1), several(4);
+    IS_TRUE(generate_points(10000, PointDistribution::CLUSTERED, 42, single, 100) == points);
+    IS_TRUE(generate_points(10000, PointDistribution::CLUSTERED, 42, several, 100) == points);
+
+    PointBuffer buffer;
+    generate_points(buffer, 10000, PointDistribution::CLUSTERED, 42, several, 100);
+    IS_TRUE(buffer.to_vector() == points);
+
+    // a prefix of a set is the smaller set
+    std::vector<Point> prefix = generate_points(100, PointDistribution::CLUSTERED, 42);
+    IS_TRUE(std::equal(prefix.begin(), prefix.end(), points.begin()));
+}
+
+void test_generator_distributions()
+{
+    size_t n = 20000;
+    std::vector<Point> square = generate_points(n, PointDistribution::UNIFORM_SQUARE, 1);
+    std::vector<double> xs;
+    for (Point p : square)
+    {
+        IS_TRUE(p.get_x() >= 0 && p.get_x() < 1 && p.get_y() >= 0 && p.get_y() < 1);
+        xs.push_back(p.get_x());
+    }
+    // far finer than RAND_MAX, so no two coordinates collide
+    std::sort(xs.begin(), xs.end());
+    IS_TRUE(std::adjacent_find(xs.begin(), xs.end()) == xs.end());
+
+    for (Point p : generate_points(n, PointDistribution::UNIFORM_DISK, 1))
+    {
+        IS_TRUE(std::hypot(p.get_x() - 0.5, p.get_y() - 0.5) <= 0.5 + 1e-12);
+    }
+
+    std::vector<Point> circle = generate_points(1000, PointDistribution::CIRCLE, 1);
+    for (Point p : circle)
+    {
+        IS_TRUE(std::fabs(std::hypot(p.get_x() - 0.5, p.get_y() - 0.5) - 0.5) < 1e-12);
+    }
+    IS_TRUE(monotone_chain(circle).size() > 900);
+
+    double mean = 0;
+    for (Point p : generate_points(n, PointDistribution::GAUSSIAN, 1))
+    {
+        mean += p.get_x() / (double)n;
+    }
+    IS_TRUE(std::fabs(mean - 0.5) < 0.01);
+
+    std::vector<Point> duplicates = generate_points(n, PointDistribution::DUPLICATES, 1);
+    std::sort(duplicates.begin(), duplicates.end(), [](Point a, Point b)
+              { return a.get_x() < b.get_x() || (a.get_x() == b.get_x() && a.get_y() < b.get_y()); });
+    duplicates.erase(std::unique(duplicates.begin(), duplicates.end()), duplicates.end());
+    IS_TRUE(duplicates.size() <= DUPLICATE_POOL_SIZE);
+
+    IS_EQUAL(monotone_chain(generate_points(n, PointDistribution::COLLINEAR, 1)).size(), 2);
+}
+
+void test_generator()
+{
+    test_generator_is_reproducible();
+    test_generator_distributions();
+}
@@ -131,6 +131,69 @@ void test_line_subtraction()
     IS_EQUAL(sub_line.get_end(), end - p2);
 }
 
+void test_two_sum_and_two_product_are_exact()
+{
+    double sum, sum_error, product, product_error;
+    two_sum(1.0, 0x1.0p-60, sum, sum_error);
+    IS_EQUAL(sum, 1.0);
+    IS_EQUAL(sum_error, 0x1.0p-60);
+
+    two_product(1.0 + 0x1.0p-30, 1.0 + 0x1.0p-30, product, product_error);
+    IS_EQUAL(product, 1.0 + 0x1.0p-29);
+    IS_EQUAL(product_error, 0x1.0p-60);
+}
+
+void test_orient2d_sign_on_an_ulp_grid()
+{
+    // the orientation of p against the line through (12, 12) and (24, 24) is 12 * (p.y - p.x), whose sign is known
+    // exactly, while the floating point cross product gets it wrong on this grid
+    Point a = Point(12, 12), b = Point(24, 24);
+    int wrong_cross_products = 0;
+    for (int i = 0; i < 32; i++)
+    {
+        for (int j = 0; j < 32; j++)
+        {
+            Point p = Point(0.5 + i * 0x1.0p-53, 0.5 + j * 0x1.0p-53);
+            int expected = (j > i) - (j < i);
+            double orientation = orient2d(p, a, b);
+            IS_EQUAL((orientation > 0) - (orientation < 0), expected);
+            IS_EQUAL((orient2d(a, b, p) > 0) - (orient2d(a, b, p) < 0), expected);
+
+            double cross = cross_product(p, a, b);
+            wrong_cross_products += (cross > 0) - (cross < 0) != expected;
+        }
+    }
+    IS_TRUE(wrong_cross_products > 0);
+
+    IS_EQUAL(orient2d(Point(0, 0), Point(1, 0), Point(0, 1)), 1.0);
+    IS_EQUAL(orient2d(Point(0, 0), Point(0, 1), Point(1, 0)), -1.0);
+}
+
+void test_integer_points()
+{
+    IntPoint p1 = IntPoint(0, 0), p2 = IntPoint(3, 4);
+
+    IS_EQUAL(sizeof(IntPoint), 2 * sizeof(int32_t));
+    IS_EQUAL(p1.distance_to(p2), 5.0);
+    IS_TRUE(p1 < p2);
+    IS_EQUAL(p2 - p1, p2);
+
+    IntLine line = IntLine(IntPoint(0, 0), IntPoint(0, 1));
+    IS_TRUE(line.is_point_on_left_of_line(IntPoint(1, 0)));
+    IS_FALSE(line.is_point_on_left_of_line(IntPoint(-1, 0)));
+    IS_EQUAL(line.distance_from_point(IntPoint(1, 0)), 1);
+}
+
+void test_integer_orient2d_does_not_overflow()
+{
+    // the products of the differences need 64 bits, which an int64_t cross product would overflow
+    IntPoint o = IntPoint(INT32_MIN, INT32_MIN), a = IntPoint(INT32_MAX, INT32_MAX), b = IntPoint(INT32_MAX - 1, INT32_MAX);
+
+    IS_TRUE(orient2d(o, a, b) == (int128_t)UINT32_MAX);
+    IS_TRUE(orient2d(o, b, a) == -(int128_t)UINT32_MAX);
+    IS_TRUE(orient2d(o, a, IntPoint(0, 0)) == 0);
+    IS_TRUE(cross_product(BasicPoint<int16_t>(0, 0), BasicPoint<int16_t>(1, 0), BasicPoint<int16_t>(0, 1)) == 1);
+}
 
 void test_geometry()
 {
@@ -161,4 +224,13 @@ void test_geometry()
     test_point_on_the_left_of_the_line();
 
     test_line_subtraction();
+
+    // run predicate unit tests
+    test_two_sum_and_two_product_are_exact();
+
+    test_orient2d_sign_on_an_ulp_grid();
+
+    test_integer_points();
+
+    test_integer_orient2d_does_not_overflow();
 }
\ No newline at end of file
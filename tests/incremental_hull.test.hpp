@@ -0,0 +1,89 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include "../tester.hpp"
+#include "../utils.hpp"
+#include "../convex_hull.hpp"
+#include "../incremental_hull.hpp"
+
+std::vector<Point> incremental_hull_vertices(const IncrementalHull &hull)
+{
+    std::vector<Point> vertices;
+    for (Point p : hull.vertices())
+    {
+        vertices.push_back(p);
+    }
+    return vertices;
+}
+
+void test_incremental_hull_rejects_inside_points()
+{
+    IncrementalHull hull;
+
+    IS_TRUE(hull.empty());
+    IS_TRUE(hull.insert(Point(0, 0)));
+    IS_TRUE(hull.insert(Point(1, 0)));
+    IS_TRUE(hull.insert(Point(1, 1)));
+    IS_TRUE(hull.insert(Point(0, 1)));
+    IS_FALSE(hull.insert(Point(0.5, 0.5)));
+    IS_FALSE(hull.insert(Point(0.5, 0)));
+    IS_FALSE(hull.insert(Point(1, 1)));
+    IS_EQUAL(hull.size(), 4);
+
+    std::vector<Point> expected = {Point(0, 0), Point(1, 0), Point(1, 1), Point(0, 1)};
+    IS_TRUE(incremental_hull_vertices(hull) == expected);
+}
+
+void test_incremental_hull_degenerate_hulls()
+{
+    IncrementalHull hull;
+    hull.insert(Point(1, 1));
+    IS_EQUAL(hull.size(), 1);
+
+    hull.insert(Point(1, 1));
+    IS_EQUAL(hull.size(), 1);
+
+    hull.insert(Point(3, 3));
+    hull.insert(Point(2, 2));
+    std::vector<Point> segment = {Point(1, 1), Point(3, 3)};
+    IS_TRUE(incremental_hull_vertices(hull) == segment);
+
+    IncrementalHull vertical;
+    vertical.insert(Point(0, 0));
+    vertical.insert(Point(0, 2));
+    vertical.insert(Point(0, 1));
+    std::vector<Point> vertical_segment = {Point(0, 0), Point(0, 2)};
+    IS_TRUE(incremental_hull_vertices(vertical) == vertical_segment);
+}
+
+void test_incremental_hull_matches_monotone_chain()
+{
+    std::vector<Point> points = generate_random_data_points(2000);
+    IncrementalHull hull;
+    bool all_match = true;
+
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        hull.insert(points[i]);
+        if (i % 97 == 0)
+        {
+            std::vector<Point> prefix(points.begin(), points.begin() + (long)i + 1);
+            all_match = all_match && incremental_hull_vertices(hull) == monotone_chain(prefix);
+        }
+    }
+    IS_TRUE(all_match);
+
+    IncrementalHull batched;
+    batched.insert(std::span<const Point>(points));
+    IS_TRUE(incremental_hull_vertices(batched) == monotone_chain(points));
+}
+
+void test_incremental_hull()
+{
+    test_incremental_hull_rejects_inside_points();
+
+    test_incremental_hull_degenerate_hulls();
+
+    test_incremental_hull_matches_monotone_chain();
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+#include "../tester.hpp"
+#include "../merge_hull.hpp"
+#include "../generator.hpp"
+
+void test_sorted_hull_vertices()
+{
+    std::vector<Point> hull = monotone_chain(generate_points(1000, PointDistribution::UNIFORM_DISK, 3));
+    std::vector<Point> sorted(hull.size());
+    IS_TRUE(sorted_hull_vertices<double>(hull, sorted.data()) == sorted.data() + sorted.size());
+    std::vector<Point> expected = hull;
+    sort(expected.begin(), expected.end());
+    IS_TRUE(sorted == expected);
+
+    // vertical edges at both ends, where the chains meet
+    std::vector<Point> square = {Point(0, 0), Point(1, 0), Point(1, 1), Point(0, 1)};
+    IS_TRUE(sorted_hull_vertices<double>(square, sorted.data()) == sorted.data() + 4);
+    IS_TRUE(std::vector<Point>(sorted.begin(), sorted.begin() + 4) == (std::vector<Point>{Point(0, 0), Point(0, 1), Point(1, 0), Point(1, 1)}));
+}
+
+void test_merge_two_hulls()
+{
+    // disjoint, overlapping and nested hulls, and hulls sharing vertices
+    bool all_match = true;
+    for (uint64_t seed = 0; seed < 300; seed++)
+    {
+        std::vector<Point> first = generate_points(1 + seed % 50, seed % 2 ? PointDistribution::UNIFORM_SQUARE : PointDistribution::DUPLICATES, seed);
+        std::vector<Point> second = generate_points(1 + seed % 70, PointDistribution::UNIFORM_DISK, seed + 1000);
+        double shift = (double)(seed % 5) * 0.4;
+        for (Point &p : second)
+        {
+            p = Point(p.get_x() + shift, p.get_y() * 0.5 + shift / 2);
+        }
+        std::vector<Point> all = first;
+        all.insert(all.end(), second.begin(), second.end());
+        std::vector<Point> merged = merge_hulls(monotone_chain(first), monotone_chain(second));
+        all_match = all_match && merged == monotone_chain(all);
+        all_match = all_match && merge_hulls(merged, monotone_chain(first)) == merged;
+    }
+    IS_TRUE(all_match);
+
+    std::vector<Point> empty, point = {Point(2, 2)}, segment = {Point(0, 0), Point(4, 4)};
+    IS_TRUE(merge_hulls(empty, empty).empty());
+    IS_TRUE(merge_hulls(empty, point) == point);
+    IS_TRUE(merge_hulls(point, segment) == segment);
+    IS_TRUE(merge_hulls(segment, std::vector<Point>{Point(4, 0)}) == (std::vector<Point>{Point(0, 0), Point(4, 0), Point(4, 4)}));
+
+    // integer hulls merge exactly
+    std::vector<IntPoint> a = {IntPoint(INT32_MIN, INT32_MIN), IntPoint(INT32_MAX, INT32_MIN + 1), IntPoint(0, 0)};
+    std::vector<IntPoint> b = {IntPoint(-1, -1), IntPoint(INT32_MAX, INT32_MAX), IntPoint(INT32_MIN + 1, INT32_MAX)};
+    std::vector<IntPoint> all = a;
+    all.insert(all.end(), b.begin(), b.end());
+    IS_TRUE(merge_hulls(monotone_chain(a), monotone_chain(b)) == monotone_chain(all));
+}
+
+void test_merge_many_hulls()
+{
+    std::vector<Point> points = generate_points(20000, PointDistribution::CLUSTERED, 11);
+    ThreadPool pool(4);
+    std::vector<Point> expected = monotone_chain(points);
+    bool all_match = true;
+    for (size_t shard_count : {(size_t)1, (size_t)2, (size_t)3, (size_t)7, (size_t)64})
+    {
+        std::vector<std::vector<Point>> hulls(shard_count);
+        for (size_t i = 0; i < shard_count; i++)
+        {
+            size_t shard_begin = points.size() * i / shard_count, shard_end = points.size() * (i + 1) / shard_count;
+            hulls[i] = monotone_chain(std::vector<Point>(points.begin() + (ptrdiff_t)shard_begin, points.begin() + (ptrdiff_t)shard_end));
+        }
+        all_match = all_match && merge_hulls(hulls, pool, 1) == expected;
+    }
+    IS_TRUE(all_match);
+    IS_TRUE(merge_hulls(std::vector<std::vector<Point>>(), pool).empty());
+
+    // the hulls of a batch, split between threads
+    std::vector<size_t> offsets;
+    for (size_t i = 0; i <= 100; i++)
+    {
+        offsets.push_back(points.size() * i / 100);
+    }
+    HullBatch batch;
+    IS_TRUE(batch_convex_hull(points, offsets, batch, pool));
+    IS_TRUE(merge_hulls(batch, pool, 2) == expected);
+}
+
+void test_merge_hull()
+{
+    test_sorted_hull_vertices();
+
+    test_merge_two_hulls();
+
+    test_merge_many_hulls();
+}
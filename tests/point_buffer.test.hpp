@@ -0,0 +1,146 @@
+#pragma once
+
+#include <vector>
+#include "../tester.hpp"
+#include "../utils.hpp"
+#include "../point_buffer.hpp"
+#include "../kernels.hpp"
+
+void test_point_buffer_from_vector()
+{
+    std::vector<Point> points = {Point(1, 2), Point(3, 4), Point(5, 6)};
+    PointBuffer buffer(points);
+
+    IS_EQUAL(buffer.size(), 3);
+    IS_EQUAL(buffer.x()[1], 3);
+    IS_EQUAL(buffer.y()[2], 6);
+    IS_EQUAL(buffer.get(0), Point(1, 2));
+    IS_TRUE(buffer.to_vector() == points);
+}
+
+void test_point_buffer_alignment_and_growth()
+{
+    PointBuffer buffer;
+    for (int i = 0; i < 100; i++)
+    {
+        buffer.push_back(Point(i, -i));
+    }
+
+    IS_EQUAL(buffer.size(), 100);
+    IS_EQUAL(buffer.get(99), Point(99, -99));
+    IS_EQUAL((uintptr_t)buffer.x() % POINT_BUFFER_ALIGNMENT, 0);
+    IS_EQUAL((uintptr_t)buffer.y() % POINT_BUFFER_ALIGNMENT, 0);
+
+    buffer.swap_points(0, 99);
+    IS_EQUAL(buffer.get(0), Point(99, -99));
+
+    PointBuffer copy = buffer;
+    buffer.resize(10);
+    IS_EQUAL(buffer.size(), 10);
+    IS_EQUAL(copy.size(), 100);
+}
+
+void test_classify_points_kernel()
+{
+    std::vector<Point> points = generate_random_data_points(1001);
+    PointBuffer buffer(points);
+    std::vector<int8_t> sides(points.size());
+    Point start = Point(0.1, 0.2), finish = Point(0.9, 0.7);
+
+    classify_points(buffer.x(), buffer.y(), buffer.size(), start, finish, sides.data());
+
+    bool all_match = true;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        double cross = cross_product(start, finish, points[i]);
+        all_match = all_match && sides[i] == (cross > 0) - (cross < 0);
+    }
+    IS_TRUE(all_match);
+
+    // an array of Points gives the same sides as a structure of arrays
+    std::vector<int8_t> point_sides(points.size());
+    classify_points(points.data(), points.size(), start, finish, point_sides.data());
+    IS_TRUE(point_sides == sides);
+
+    std::vector<Point> on_line = {Point(0, 0), Point(1, 1), Point(2, 2)};
+    PointBuffer line_buffer(on_line);
+    classify_points(line_buffer.x(), line_buffer.y(), line_buffer.size(), Point(0, 0), Point(3, 3), sides.data());
+    IS_EQUAL((int)sides[1], 0);
+}
+
+void test_farthest_point_kernel()
+{
+    std::vector<Point> points = generate_random_data_points(1003);
+    PointBuffer buffer(points);
+    Point start = Point(0, 0), finish = Point(1, 0);
+
+    size_t expected = 0;
+    for (size_t i = 1; i < points.size(); i++)
+    {
+        if (cross_product(start, finish, points[i]) > cross_product(start, finish, points[expected]))
+        {
+            expected = i;
+        }
+    }
+    double max_cross;
+    IS_EQUAL(farthest_point(buffer.x(), buffer.y(), buffer.size(), start, finish, &max_cross), expected);
+    IS_EQUAL(max_cross, cross_product(start, finish, points[expected]));
+    IS_EQUAL(farthest_point(points.data(), points.size(), start, finish), expected);
+
+    // ties go to the lexicographically smallest point, which is an end of the segment they lie on
+    std::vector<Point> ties = {Point(0, 0), Point(4, 1), Point(2, 1), Point(6, 1), Point(5, 1), Point(1, 1), Point(3, 1), Point(7, 0), Point(8, 1)};
+    PointBuffer ties_buffer(ties);
+    IS_EQUAL(farthest_point(ties_buffer.x(), ties_buffer.y(), ties_buffer.size(), start, finish), 5);
+    IS_EQUAL(farthest_point(ties.data(), ties.size(), start, finish), 5);
+}
+
+void test_avx2_kernels_match_baseline()
+{
+#if defined(KERNELS_AVX2)
+    // the AVX2 kernels are compiled into every x86 build and picked at runtime, so they are only run where supported
+    if (!kernels_use_avx2())
+    {
+        return;
+    }
+    std::vector<Point> points = generate_random_data_points(1003);
+    // points on the line and ties for the farthest point
+    for (int i = 0; i < 40; i++)
+    {
+        points.push_back(Point(i % 7, i % 7));
+        points.push_back(Point(i % 5, 2));
+    }
+    PointBuffer buffer(points);
+    const double *coordinates = point_coordinates(points.data());
+    Point start = Point(0, 0), finish = Point(3, 3);
+
+    std::vector<int8_t> avx2_sides(points.size()), baseline_sides(points.size());
+    classify_strided_points_avx2<1>(buffer.x(), buffer.y(), buffer.size(), start, finish, avx2_sides.data());
+    classify_strided_points_baseline<1>(buffer.x(), buffer.y(), buffer.size(), start, finish, baseline_sides.data());
+    IS_TRUE(avx2_sides == baseline_sides);
+    classify_strided_points_avx2<2>(coordinates, coordinates + 1, points.size(), start, finish, avx2_sides.data());
+    IS_TRUE(avx2_sides == baseline_sides);
+
+    for (Point line_finish : {Point(3, 3), Point(1, 0), Point(-1, 0)})
+    {
+        // duplicates of the farthest point may be picked at different indices
+        double avx2_cross, baseline_cross;
+        Point expected = points[farthest_strided_point_baseline<1>(buffer.x(), buffer.y(), buffer.size(), start, line_finish, baseline_cross)];
+        IS_EQUAL(points[farthest_strided_point_avx2<1>(buffer.x(), buffer.y(), buffer.size(), start, line_finish, avx2_cross)], expected);
+        IS_EQUAL(avx2_cross, baseline_cross);
+        IS_EQUAL(points[farthest_strided_point_avx2<2>(coordinates, coordinates + 1, points.size(), start, line_finish, avx2_cross)], expected);
+    }
+#endif
+}
+
+void test_point_buffer()
+{
+    test_point_buffer_from_vector();
+
+    test_point_buffer_alignment_and_growth();
+
+    test_classify_points_kernel();
+
+    test_farthest_point_kernel();
+
+    test_avx2_kernels_match_baseline();
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+#include "../tester.hpp"
+#include "../point_file.hpp"
+#include "../utils.hpp"
+
+void test_point_file_round_trip()
+{
+    const char *filename = "point_file_test.bin";
+    std::vector<Point> points = {Point(0.5, 0.25), Point(-1, 2), Point(3, -4)};
+
+    for (PointLayout layout : {PointLayout::ARRAY_OF_STRUCTURES, PointLayout::STRUCTURE_OF_ARRAYS})
+    {
+        IS_TRUE(write_point_file(filename, points, layout));
+        MappedPointFile file;
+        IS_TRUE(file.open(filename));
+        IS_TRUE(file.layout() == layout);
+        IS_EQUAL(file.size(), 3);
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            IS_TRUE(file.get(i) == points[i]);
+        }
+        // only the span matching the layout is exposed
+        IS_EQUAL(file.points().size(), (layout == PointLayout::ARRAY_OF_STRUCTURES ? 3u : 0u));
+        IS_EQUAL(file.x().size(), (layout == PointLayout::STRUCTURE_OF_ARRAYS ? 3u : 0u));
+    }
+
+    PointBuffer buffer(points);
+    IS_TRUE(write_point_file(filename, buffer));
+    MappedPointFile file;
+    IS_TRUE(file.open(filename));
+    IS_TRUE(file.layout() == PointLayout::STRUCTURE_OF_ARRAYS);
+    IS_TRUE(file.y()[2] == -4);
+    file.close();
+    IS_TRUE(!file.is_open());
+    remove(filename);
+}
+
+void test_point_file_rejects_invalid_files()
+{
+    const char *filename = "point_file_test.bin";
+    MappedPointFile file;
+    IS_TRUE(!file.open("point_file_that_does_not_exist.bin"));
+
+    // a header announcing more points than the file holds
+    std::vector<Point> points = {Point(0, 0), Point(1, 1)};
+    IS_TRUE(write_point_file(filename, points, PointLayout::ARRAY_OF_STRUCTURES));
+    FILE *truncated = fopen(filename, "r+b");
+    PointFileHeader header = make_point_file_header(3, PointLayout::ARRAY_OF_STRUCTURES);
+    fwrite(&header, sizeof(header), 1, truncated);
+    fclose(truncated);
+    IS_TRUE(!file.open(filename));
+
+    FILE *garbage = fopen(filename, "wb");
+    fputs("not a point file, but long enough to hold a header of sixty-four bytes", garbage);
+    fclose(garbage);
+    IS_TRUE(!file.open(filename));
+    IS_TRUE(!file.is_open());
+    remove(filename);
+}
+
+void test_mapped_point_file_hull()
+{
+    const char *filename = "point_file_test.bin";
+    std::vector<Point> points = generate_random_data_points(20000);
+    points.push_back(Point(0.5, 0.5));
+    std::vector<Point> expected = monotone_chain(points);
+
+    for (PointLayout layout : {PointLayout::ARRAY_OF_STRUCTURES, PointLayout::STRUCTURE_OF_ARRAYS})
+    {
+        IS_TRUE(write_point_file(filename, points, layout));
+        MappedPointFile file;
+        IS_TRUE(file.open(filename));
+        size_t survivors = 0;
+        HullOptions options;
+        options.survivors = &survivors;
+        IS_TRUE(convex_hull(file, options) == expected);
+        // the engine only ran on the points outside the octagon
+        IS_TRUE(survivors < points.size());
+    }
+    remove(filename);
+
+    MappedPointFile closed;
+    IS_TRUE(convex_hull(closed).empty());
+}
+
+void test_point_file()
+{
+    test_point_file_round_trip();
+    test_point_file_rejects_invalid_files();
+    test_mapped_point_file_hull();
+}
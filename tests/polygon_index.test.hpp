@@ -0,0 +1,126 @@
+#pragma once
+
+#include <vector>
+#include "../tester.hpp"
+#include "../polygon_index.hpp"
+#include "../convex_hull.hpp"
+#include "../generator.hpp"
+
+// locates a point in O(h) by checking its turn against every edge
+PointLocation locate_by_edges(const std::vector<Point> &polygon, Point p)
+{
+    bool on_edge = false;
+    for (size_t i = 0; i < polygon.size(); i++)
+    {
+        double turn = orient2d(polygon[i], polygon[(i + 1) % polygon.size()], p);
+        if (turn < 0)
+        {
+            return PointLocation::OUTSIDE;
+        }
+        on_edge = on_edge || turn == 0;
+    }
+    return on_edge ? PointLocation::BOUNDARY : PointLocation::INSIDE;
+}
+
+void test_polygon_index_matches_edge_checks()
+{
+    // a hull on a grid, so that many probes are exactly on its edges or vertices
+    std::vector<Point> points;
+    for (uint64_t i = 0; i < 200; i++)
+    {
+        points.push_back(Point((double)(random_bits(9, i, 0) % 64), (double)(random_bits(9, i, 1) % 64)));
+    }
+    std::vector<Point> hull = monotone_chain(points);
+    ConvexPolygonIndex index(hull);
+    IS_EQUAL(index.size(), hull.size());
+
+    PointBuffer probes;
+    for (int x = -2; x < 67; x++)
+    {
+        for (int y = -2; y < 67; y++)
+        {
+            probes.push_back(Point(x, y));
+            probes.push_back(Point(x + 0.5, y + 0.25));
+        }
+    }
+    bool all_match = true;
+    size_t counts[3] = {0, 0, 0};
+    for (size_t i = 0; i < probes.size(); i++)
+    {
+        PointLocation location = index.locate(probes.get(i));
+        all_match = all_match && location == locate_by_edges(hull, probes.get(i));
+        counts[(size_t)location]++;
+    }
+    IS_TRUE(all_match);
+    IS_TRUE(counts[0] > 0 && counts[1] > 0 && counts[2] > 0);
+
+    // the batch, split between threads, agrees with the single queries
+    ThreadPool pool(4);
+    std::vector<PointLocation> locations;
+    index.locate(probes, locations, pool, 64);
+    IS_EQUAL(locations.size(), probes.size());
+    for (size_t i = 0; i < probes.size(); i++)
+    {
+        all_match = all_match && locations[i] == index.locate(probes.get(i));
+    }
+    IS_TRUE(all_match);
+}
+
+void test_polygon_index_near_the_boundary()
+{
+    // probes a few ulps off the edges of a random hull, where a floating point cross product has the wrong sign
+    std::vector<Point> hull = monotone_chain(generate_points(1000, PointDistribution::UNIFORM_DISK, 5));
+    ConvexPolygonIndex index(hull);
+    PointBuffer probes;
+    for (size_t i = 0; i < hull.size(); i++)
+    {
+        Point a = hull[i], b = hull[(i + 1) % hull.size()];
+        for (int k = 1; k < 8; k++)
+        {
+            double x = a.get_x() + (b.get_x() - a.get_x()) * k / 8, y = a.get_y() + (b.get_y() - a.get_y()) * k / 8;
+            probes.push_back(Point(x, y));
+            probes.push_back(Point(std::nextafter(x, 0.5), y));
+            probes.push_back(Point(x, std::nextafter(y, 10.0)));
+        }
+        probes.push_back(a);
+    }
+    std::vector<PointLocation> locations;
+    index.locate(probes, locations);
+    bool all_match = true;
+    for (size_t i = 0; i < probes.size(); i++)
+    {
+        all_match = all_match && locations[i] == locate_by_edges(hull, probes.get(i));
+    }
+    IS_TRUE(all_match);
+}
+
+void test_polygon_index_degenerate_polygons()
+{
+    ConvexPolygonIndex empty(std::vector<Point>{});
+    IS_TRUE(empty.locate(Point(0, 0)) == PointLocation::OUTSIDE);
+
+    ConvexPolygonIndex point(std::vector<Point>{Point(1, 1)});
+    IS_TRUE(point.locate(Point(1, 1)) == PointLocation::BOUNDARY);
+    IS_FALSE(point.contains(Point(1, 2)));
+
+    ConvexPolygonIndex segment(std::vector<Point>{Point(0, 0), Point(2, 2)});
+    IS_TRUE(segment.locate(Point(1, 1)) == PointLocation::BOUNDARY);
+    IS_TRUE(segment.locate(Point(3, 3)) == PointLocation::OUTSIDE);
+    IS_TRUE(segment.locate(Point(1, 0)) == PointLocation::OUTSIDE);
+
+    ConvexPolygonIndex triangle(std::vector<Point>{Point(0, 0), Point(4, 0), Point(0, 4)});
+    IS_TRUE(triangle.locate(Point(1, 1)) == PointLocation::INSIDE);
+    IS_TRUE(triangle.locate(Point(2, 2)) == PointLocation::BOUNDARY);
+    IS_TRUE(triangle.locate(Point(0, 0)) == PointLocation::BOUNDARY);
+    IS_TRUE(triangle.locate(Point(-1, 0)) == PointLocation::OUTSIDE);
+    IS_TRUE(triangle.locate(Point(0, 5)) == PointLocation::OUTSIDE);
+}
+
+void test_polygon_index()
+{
+    test_polygon_index_matches_edge_checks();
+
+    test_polygon_index_near_the_boundary();
+
+    test_polygon_index_degenerate_polygons();
+}
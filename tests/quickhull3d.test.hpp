@@ -0,0 +1,225 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+#include "../tester.hpp"
+#include "../quickhull3d.hpp"
+#include "../generator.hpp"
+
+enum class CloudShape
+{
+    CUBE,
+    SPHERE,
+    GRID,
+    JITTERED_GRID
+};
+
+std::vector<Point3D> random_cloud(size_t count, CloudShape shape, uint64_t seed)
+{
+    std::vector<Point3D> cloud;
+    for (size_t i = 0; i < count; i++)
+    {
+        double x = random_unit(seed, i, 0), y = random_unit(seed, i, 1), z = random_unit(seed, i, 2);
+        if (shape == CloudShape::SPHERE)
+        {
+            Point normal = random_normal_pair(seed, 2 * i), other = random_normal_pair(seed, 2 * i + 1);
+            Point3D direction(normal.get_x(), normal.get_y(), other.get_x());
+            double length = direction.length();
+            x = direction.get_x() / length;
+            y = direction.get_y() / length;
+            z = direction.get_z() / length;
+        }
+        else if (shape == CloudShape::GRID)
+        {
+            x = floor(x * 5);
+            y = floor(y * 5);
+            z = floor(z * 5);
+        }
+        else if (shape == CloudShape::JITTERED_GRID)
+        {
+            // clusters of points a few ulps apart give long, thin faces and near-coplanar eyes
+            x = floor(x * 7) + (2 * random_unit(seed, i, 3) - 1) * 1e-13;
+            y = floor(y * 7) + (2 * random_unit(seed, i, 4) - 1) * 1e-13;
+            z = floor(z * 7) + (2 * random_unit(seed, i, 5) - 1) * 1e-13;
+        }
+        cloud.push_back(Point3D(x, y, z));
+    }
+    return cloud;
+}
+
+// checks that the hull is a closed triangle mesh with every point on the inner side of every face
+bool is_valid_hull(const std::vector<Point3D> &cloud, const Hull3D &hull)
+{
+    std::map<std::pair<uint32_t, uint32_t>, int> directed_edges;
+    for (const std::array<uint32_t, 3> &face : hull.faces)
+    {
+        for (size_t k = 0; k < 3; k++)
+        {
+            directed_edges[{face[k], face[(k + 1) % 3]}]++;
+        }
+    }
+    for (const auto &[edge, count] : directed_edges)
+    {
+        auto twin = directed_edges.find({edge.second, edge.first});
+        if (count != 1 || twin == directed_edges.end() || twin->second != 1)
+        {
+            return false;
+        }
+    }
+    if (hull.vertices.size() + hull.faces.size() != directed_edges.size() / 2 + 2)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < hull.vertices.size(); i++)
+    {
+        if (!(cloud[hull.input_indices[i]] == hull.vertices[i]))
+        {
+            return false;
+        }
+    }
+    for (const std::array<uint32_t, 3> &face : hull.faces)
+    {
+        Point3D a = hull.vertices[face[0]];
+        Point3D normal = (hull.vertices[face[1]] - a).cross(hull.vertices[face[2]] - a);
+        for (Point3D p : cloud)
+        {
+            if (normal.dot(p - a) > 1e-9 * normal.length())
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// the vertices of the hull of points in general position, in O(n^4): the vertices of the triangles with every point on one side
+std::vector<uint32_t> vertices_by_triangles(const std::vector<Point3D> &cloud)
+{
+    std::vector<bool> is_vertex(cloud.size(), false);
+    for (size_t i = 0; i < cloud.size(); i++)
+    {
+        for (size_t j = i + 1; j < cloud.size(); j++)
+        {
+            for (size_t k = j + 1; k < cloud.size(); k++)
+            {
+                Point3D normal = (cloud[j] - cloud[i]).cross(cloud[k] - cloud[i]);
+                bool above = false, below = false;
+                for (Point3D p : cloud)
+                {
+                    double side = normal.dot(p - cloud[i]);
+                    above = above || side > 1e-12;
+                    below = below || side < -1e-12;
+                }
+                if (!above || !below)
+                {
+                    is_vertex[i] = is_vertex[j] = is_vertex[k] = true;
+                }
+            }
+        }
+    }
+    std::vector<uint32_t> vertices;
+    for (uint32_t i = 0; i < cloud.size(); i++)
+    {
+        if (is_vertex[i])
+        {
+            vertices.push_back(i);
+        }
+    }
+    return vertices;
+}
+
+void test_quick_hull_3d_small_clouds()
+{
+    bool all_valid = true, all_match = true;
+    for (uint64_t seed = 0; seed < 100; seed++)
+    {
+        std::vector<Point3D> cloud = random_cloud(5 + seed % 30, CloudShape::CUBE, seed);
+        Hull3D hull;
+        all_valid = all_valid && quick_hull_3d(cloud, hull) && is_valid_hull(cloud, hull);
+        std::vector<uint32_t> vertices = hull.input_indices;
+        sort(vertices.begin(), vertices.end());
+        all_match = all_match && vertices == vertices_by_triangles(cloud);
+    }
+    IS_TRUE(all_valid);
+    IS_TRUE(all_match);
+}
+
+void test_quick_hull_3d_large_clouds()
+{
+    ThreadPool pool(4), one(1);
+    bool all_valid = true, all_same = true;
+    for (CloudShape shape : {CloudShape::CUBE, CloudShape::SPHERE, CloudShape::GRID})
+    {
+        for (uint64_t seed = 0; seed < 3; seed++)
+        {
+            std::vector<Point3D> cloud = random_cloud(shape == CloudShape::SPHERE ? 1000 : 5000, shape, seed);
+            Hull3D hull, serial;
+            all_valid = all_valid && quick_hull_3d(cloud, hull, pool, 256) && is_valid_hull(cloud, hull);
+            // the parallel assignment does not change the hull
+            all_same = all_same && quick_hull_3d(cloud, serial, one) && serial.input_indices == hull.input_indices && serial.faces == hull.faces;
+            if (shape == CloudShape::GRID)
+            {
+                // the corners of the grid
+                all_valid = all_valid && hull.vertices.size() == 8;
+            }
+        }
+    }
+    IS_TRUE(all_valid);
+    IS_TRUE(all_same);
+}
+
+void test_quick_hull_3d_jittered_grid()
+{
+    bool all_valid = true;
+    for (uint64_t seed = 1; seed <= 40; seed++)
+    {
+        std::vector<Point3D> cloud = random_cloud(4000, CloudShape::JITTERED_GRID, seed);
+        Hull3D hull;
+        all_valid = all_valid && quick_hull_3d(cloud, hull) && is_valid_hull(cloud, hull);
+    }
+    IS_TRUE(all_valid);
+}
+
+void test_quick_hull_3d_degenerate_clouds()
+{
+    Hull3D hull;
+    std::vector<Point3D> tetrahedron = {Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(0, 1, 0), Point3D(0, 0, 1)};
+    IS_TRUE(quick_hull_3d(tetrahedron, hull));
+    IS_EQUAL(hull.vertices.size(), 4);
+    IS_EQUAL(hull.faces.size(), 4);
+    IS_TRUE(is_valid_hull(tetrahedron, hull));
+
+    // the corners of a cube, points on its faces and edges, and duplicates
+    std::vector<Point3D> cube;
+    for (int i = 0; i < 27; i++)
+    {
+        cube.push_back(Point3D(i % 3, i / 3 % 3, i / 9));
+        cube.push_back(Point3D(i % 3, i / 3 % 3, i / 9));
+    }
+    IS_TRUE(quick_hull_3d(cube, hull));
+    IS_EQUAL(hull.vertices.size(), 8);
+    IS_EQUAL(hull.faces.size(), 12);
+    IS_TRUE(is_valid_hull(cube, hull));
+
+    // no volume
+    std::vector<Point3D> square = {Point3D(0, 0, 1), Point3D(1, 0, 1), Point3D(1, 1, 1), Point3D(0, 1, 1), Point3D(0.5, 0.5, 1)};
+    IS_FALSE(quick_hull_3d(square, hull));
+    IS_TRUE(hull.faces.empty());
+    IS_FALSE(quick_hull_3d(std::vector<Point3D>{Point3D(0, 0, 0), Point3D(1, 1, 1), Point3D(2, 2, 2), Point3D(3, 3, 3)}, hull));
+    IS_FALSE(quick_hull_3d(std::vector<Point3D>(tetrahedron.begin(), tetrahedron.begin() + 3), hull));
+    IS_FALSE(quick_hull_3d(std::vector<Point3D>(), hull));
+}
+
+void test_quick_hull_3d()
+{
+    test_quick_hull_3d_small_clouds();
+
+    test_quick_hull_3d_large_clouds();
+
+    test_quick_hull_3d_jittered_grid();
+
+    test_quick_hull_3d_degenerate_clouds();
+}
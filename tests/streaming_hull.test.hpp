@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+#include "../tester.hpp"
+#include "../streaming_hull.hpp"
+#include "../utils.hpp"
+
+void test_streaming_hull_matches_in_memory_hull()
+{
+    const char *filename = "streaming_hull_test.bin";
+    std::vector<Point> points = generate_random_data_points(20000);
+    std::vector<Point> expected = monotone_chain(points);
+
+    for (PointLayout layout : {PointLayout::ARRAY_OF_STRUCTURES, PointLayout::STRUCTURE_OF_ARRAYS})
+    {
+        IS_TRUE(write_point_file(filename, points, layout));
+        StreamingHullResult result = streaming_convex_hull(filename, 1000);
+        IS_TRUE(result.complete);
+        IS_EQUAL(result.points, points.size());
+        IS_EQUAL(result.chunks, 20);
+        IS_TRUE(result.hull == expected);
+    }
+
+    // raw x, y pairs without a header, with a last chunk that is not full
+    FILE *raw = fopen(filename, "wb");
+    fwrite(points.data(), sizeof(Point), points.size(), raw);
+    fclose(raw);
+    StreamingHullResult result = streaming_convex_hull(filename, 3000);
+    IS_TRUE(result.complete);
+    IS_EQUAL(result.points, points.size());
+    IS_EQUAL(result.chunks, 7);
+    IS_TRUE(result.hull == expected);
+    remove(filename);
+}
+
+void test_streaming_hull_reports_incomplete_input()
+{
+    const char *filename = "streaming_hull_test.bin";
+    IS_TRUE(!streaming_convex_hull("streaming_hull_file_that_does_not_exist.bin").complete);
+
+    // a raw stream ending in the middle of a point
+    std::vector<Point> points = {Point(0, 0), Point(1, 0), Point(0, 1), Point(1, 1), Point(2, 2)};
+    FILE *raw = fopen(filename, "wb");
+    fwrite(points.data(), sizeof(Point), points.size(), raw);
+    fwrite(points.data(), 1, 3, raw);
+    fclose(raw);
+    StreamingHullResult result = streaming_convex_hull(filename, 2);
+    IS_TRUE(!result.complete);
+    IS_EQUAL(result.points, 5);
+
+    // a point file holding fewer points than its header says
+    IS_TRUE(write_point_file(filename, points, PointLayout::ARRAY_OF_STRUCTURES));
+    FILE *truncated = fopen(filename, "r+b");
+    PointFileHeader header = make_point_file_header(6, PointLayout::ARRAY_OF_STRUCTURES);
+    fwrite(&header, sizeof(header), 1, truncated);
+    fclose(truncated);
+    result = streaming_convex_hull(filename, 4);
+    IS_TRUE(!result.complete);
+    IS_EQUAL(result.hull.size(), 4);
+    remove(filename);
+
+    IS_TRUE(streaming_convex_hull(filename).hull.empty());
+}
+
+void test_streaming_hull()
+{
+    test_streaming_hull_matches_in_memory_hull();
+    test_streaming_hull_reports_incomplete_input();
+}
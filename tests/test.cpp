@@ -1,10 +1,61 @@
 #include <iostream>
 #include "geometry.test.hpp"
 #include "utils.test.hpp"
+#include "convex_hull.test.hpp"
+#include "point_buffer.test.hpp"
+#include "incremental_hull.test.hpp"
+#include "dynamic_hull.test.hpp"
+#include "bmp.test.hpp"
+#include "framebuffer.test.hpp"
+#include "point_file.test.hpp"
+#include "streaming_hull.test.hpp"
+#include "generator.test.hpp"
+#include "batch_hull.test.hpp"
+#include "arena.test.hpp"
+#include "polygon_index.test.hpp"
+#include "calipers.test.hpp"
+#include "merge_hull.test.hpp"
+#include "convex_polygon.test.hpp"
+#include "quickhull3d.test.hpp"
+#include "approximate_hull.test.hpp"
 
 int main()
 {
     test_geometry();
 
     test_utils();
-}
\ No newline at end of file
+
+    test_convex_hull();
+
+    test_point_buffer();
+
+    test_incremental_hull();
+
+    test_dynamic_hull();
+
+    test_bmp();
+
+    test_framebuffer();
+
+    test_point_file();
+
+    test_streaming_hull();
+
+    test_generator();
+
+    test_batch_hull();
+
+    test_arena();
+
+    test_polygon_index();
+
+    test_calipers();
+
+    test_merge_hull();
+
+    test_convex_polygon();
+
+    test_quick_hull_3d();
+
+    test_approximate_hull();
+}
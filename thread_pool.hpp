@@ -0,0 +1,366 @@
+/**
+ * @file thread_pool.hpp
+ * @author Yassaman Ommi (ommiy@mcmaster.ca)
+ * @brief A work-stealing thread pool and fork-join helpers for the parallel hull engines
+ * @version 0.1
+ * @date 2023-01-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A pool of worker threads, each owning a deque of tasks
+ * a worker pushes and pops its own tasks at the back (LIFO, which keeps the recursion depth-first and cache friendly)
+ * and steals from the front of the other workers' deques when it runs out of work
+ */
+class ThreadPool
+{
+private:
+    /**
+     * @brief The task deque owned by one worker
+     */
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pending;
+    std::atomic<size_t> next_queue;
+    std::atomic<bool> stopping;
+    std::mutex sleep_mutex;
+    std::condition_variable wake_up;
+
+    /**
+     * @brief The pool the current thread works for, and the index of its queue
+     */
+    static inline thread_local ThreadPool *current_pool = nullptr;
+    static inline thread_local size_t current_index = 0;
+
+    /**
+     * @brief Pop a task from the back of the given queue
+     *
+     * @param index the queue to pop from
+     * @param task where the task is stored
+     * @return true if a task was popped
+     */
+    bool pop_back(size_t index, std::function<void()> &task)
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        if (queues[index]->tasks.empty())
+        {
+            return false;
+        }
+        task = std::move(queues[index]->tasks.back());
+        queues[index]->tasks.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief Steal a task from the front of the given queue
+     *
+     * @param index the queue to steal from
+     * @param task where the task is stored
+     * @return true if a task was stolen
+     */
+    bool steal_front(size_t index, std::function<void()> &task)
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        if (queues[index]->tasks.empty())
+        {
+            return false;
+        }
+        task = std::move(queues[index]->tasks.front());
+        queues[index]->tasks.pop_front();
+        return true;
+    }
+
+    /**
+     * @brief The loop run by every worker thread
+     *
+     * @param index the index of the worker's own queue
+     */
+    void worker_loop(size_t index)
+    {
+        current_pool = this;
+        current_index = index;
+        while (!stopping)
+        {
+            if (!run_pending_task())
+            {
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                wake_up.wait(lock, [this]
+                             { return stopping || pending > 0; });
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new Thread Pool object
+     *
+     * @param thread_count the number of worker threads, defaults to the number of hardware threads
+     */
+    explicit ThreadPool(size_t thread_count = std::thread::hardware_concurrency())
+        : pending(0), next_queue(0), stopping(false)
+    {
+        if (thread_count == 0)
+        {
+            thread_count = 1;
+        }
+        for (size_t i = 0; i < thread_count; i++)
+        {
+            queues.push_back(std::make_unique<TaskQueue>());
+        }
+        for (size_t i = 0; i < thread_count; i++)
+        {
+            workers.emplace_back([this, i]
+                                 { worker_loop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Destroy the Thread Pool object, waking up and joining every worker
+     */
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        wake_up.notify_all();
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Get the number of worker threads
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return workers.size();
+    }
+
+    /**
+     * @brief Add a task to the pool
+     * a worker pushes to its own queue, other threads spread their tasks over the queues
+     *
+     * @param task the task to run
+     */
+    void submit(std::function<void()> task)
+    {
+        size_t index = current_pool == this ? current_index : next_queue++ % queues.size();
+        // counted before it is visible, so that a thief never decrements below zero
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            pending++;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queues[index]->mutex);
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        wake_up.notify_one();
+    }
+
+    /**
+     * @brief Run one pending task, from the thread's own queue if it has one, otherwise stolen from another queue
+     *
+     * @return true if a task was run
+     * @return false if there was no task to run
+     */
+    bool run_pending_task()
+    {
+        if (pending == 0)
+        {
+            return false;
+        }
+        std::function<void()> task;
+        size_t own = current_pool == this ? current_index : 0;
+        bool found = current_pool == this && pop_back(own, task);
+        for (size_t i = 0; i < queues.size() && !found; i++)
+        {
+            found = steal_front((own + i) % queues.size(), task);
+        }
+        if (!found)
+        {
+            return false;
+        }
+        pending--;
+        task();
+        return true;
+    }
+};
+
+/**
+ * @brief Get the pool shared by the parallel engines
+ *
+ * @return ThreadPool&
+ */
+ThreadPool &default_thread_pool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+/**
+ * @brief A set of forked tasks that can be joined
+ * the thread waiting on the group keeps running pending tasks, so nested fork-join never blocks a worker
+ */
+class TaskGroup
+{
+private:
+    ThreadPool &pool;
+    std::atomic<size_t> remaining;
+
+    /**
+     * @brief The first exception thrown by a task, rethrown by wait
+     */
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    /**
+     * @brief Wait until every task forked so far is done, helping the pool while waiting
+     */
+    void join()
+    {
+        while (remaining > 0)
+        {
+            if (!pool.run_pending_task())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new Task Group object
+     *
+     * @param pool_to_use the pool running the tasks
+     */
+    explicit TaskGroup(ThreadPool &pool_to_use) : pool(pool_to_use), remaining(0)
+    {
+    }
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    /**
+     * @brief Destroy the Task Group object after its tasks are done, an exception no one waited for is dropped
+     */
+    ~TaskGroup()
+    {
+        join();
+    }
+
+    /**
+     * @brief Fork a task
+     * an exception thrown by the task is kept for wait, the task still counts as done
+     *
+     * @param task the task to run
+     */
+    void run(std::function<void()> task)
+    {
+        remaining++;
+        pool.submit([this, task]
+                    {
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+            remaining--; });
+    }
+
+    /**
+     * @brief Join every task forked so far, helping the pool while waiting
+     * the first exception thrown by one of them is then rethrown
+     */
+    void wait()
+    {
+        join();
+        std::exception_ptr thrown;
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            std::swap(thrown, error);
+        }
+        if (thrown)
+        {
+            std::rethrow_exception(thrown);
+        }
+    }
+};
+
+/**
+ * @brief Get the number of chunks a range should be split into for parallel_chunks
+ * there are at most four chunks per worker, each with at least grain_size indices
+ *
+ * @param pool the pool running the chunks
+ * @param length the number of indices in the range
+ * @param grain_size the minimum number of indices in a chunk
+ * @return size_t
+ */
+size_t parallel_chunk_count(ThreadPool &pool, size_t length, size_t grain_size)
+{
+    return std::max((size_t)1, std::min(length / std::max(grain_size, (size_t)1), 4 * pool.size()));
+}
+
+/**
+ * @brief Run body(chunk, chunk_begin, chunk_end) on every chunk of [begin, end) in parallel
+ * the calling thread runs the first chunk itself
+ *
+ * @param pool the pool running the chunks
+ * @param begin first index
+ * @param end one past the last index
+ * @param chunk_count the number of chunks, usually from parallel_chunk_count
+ * @param body the function to run on every chunk
+ */
+void parallel_chunks(ThreadPool &pool, size_t begin, size_t end, size_t chunk_count, const std::function<void(size_t, size_t, size_t)> &body)
+{
+    size_t length = end - begin;
+    if (chunk_count <= 1)
+    {
+        body(0, begin, end);
+        return;
+    }
+
+    TaskGroup group(pool);
+    for (size_t chunk = 1; chunk < chunk_count; chunk++)
+    {
+        size_t chunk_begin = begin + length * chunk / chunk_count;
+        size_t chunk_end = begin + length * (chunk + 1) / chunk_count;
+        group.run([&body, chunk, chunk_begin, chunk_end]
+                  { body(chunk, chunk_begin, chunk_end); });
+    }
+    body(0, begin, begin + length / chunk_count);
+    group.wait();
+}
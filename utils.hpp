@@ -11,33 +11,28 @@
 #pragma once
 
 #include <iostream>
+#include <algorithm>
 #include <bitset>
 #include <sstream>
 #include <iomanip>
 #include <vector>
 #include <cstdlib>
-#include <ctime>
+#include <random>
 #include "geometry.hpp"
+#include "generator.hpp"
 
 /**
- * @brief Generate random data points
+ * @brief Generate random data points, uniformly in the unit square
+ * every call draws a fresh seed; use generate_points from generator.hpp for a reproducible set
  *
  * @param count the number of points to generate
  * @return std::vector<Point> a vector of randomly generated points
  */
 std::vector<Point> generate_random_data_points(uint64_t count)
 {
-    srand((unsigned)time(0));
-    std::vector<Point> data;
-
-    for (uint64_t i = 0; i < count; i++)
-    {
-        double x = (double)rand() / RAND_MAX;
-        double y = (double)rand() / RAND_MAX;
-        data.push_back(Point(x, y));
-    }
-
-    return data;
+    std::random_device device;
+    uint64_t seed = ((uint64_t)device() << 32) | device();
+    return generate_points(count, PointDistribution::UNIFORM_SQUARE, seed);
 }
 
 /**
@@ -13,6 +13,8 @@
 #include <string>
 #include <cmath>
 #include <fstream>
+#include <utility>
+#include "framebuffer.hpp"
 #include "geometry.hpp"
 
 #define PADDING 2
@@ -56,7 +58,7 @@ double **initialize_image_array(uint64_t width, uint64_t height)
  */
 inline uint64_t get_coordinate_location_on_image(double coord, uint64_t length)
 {
-    return (uint64_t)floor(coord * (length - 2 * (PADDING + POINT_THICKNESS))) + PADDING + POINT_THICKNESS;
+    return (uint64_t)floor(coord * (double)(length - 2 * (PADDING + POINT_THICKNESS))) + PADDING + POINT_THICKNESS;
 }
 
 /**
@@ -99,7 +101,7 @@ double **add_line_to_image_array(double **image_array, uint64_t width, uint64_t
     uint64_t end_point_x = get_coordinate_location_on_image(line.get_end().get_x(), width);
     uint64_t end_point_y = get_coordinate_location_on_image(line.get_end().get_y(), height);
 
-    Line image_coordinate_line = Line(Point(start_point_x, start_point_y), Point(end_point_x, end_point_y));
+    Line image_coordinate_line = Line(Point((double)start_point_x, (double)start_point_y), Point((double)end_point_x, (double)end_point_y));
 
     double slope = image_coordinate_line.slope(), intersection = image_coordinate_line.intersection();
 
@@ -128,7 +130,7 @@ double **add_line_to_image_array(double **image_array, uint64_t width, uint64_t
     {
         for (uint64_t i = start_x; i < end_x; i++)
         {
-            uint64_t y = (uint64_t)floor(slope * i + intersection);
+            uint64_t y = (uint64_t)floor(slope * (double)i + intersection);
             for (uint64_t j = i - LINE_THICKNESS; j <= i + LINE_THICKNESS; j++)
             {
                 for (uint64_t k = y - LINE_THICKNESS; k <= y + LINE_THICKNESS; k++)
@@ -141,3 +143,54 @@ double **add_line_to_image_array(double **image_array, uint64_t width, uint64_t
 
     return image_array;
 }
+
+/**
+ * @brief Get the signed pixel coordinate of a coordinate, the same mapping as get_coordinate_location_on_image
+ * coordinates outside [0, 1] map outside the padded area, or outside the image, instead of wrapping around
+ *
+ * @param coord
+ * @param length
+ * @return int64_t
+ */
+inline int64_t get_pixel_location_on_image(double coord, uint64_t length)
+{
+    return (int64_t)floor(coord * (double)(length - 2 * (PADDING + POINT_THICKNESS))) + PADDING + POINT_THICKNESS;
+}
+
+/**
+ * @brief Get the pixel a point is drawn at on a framebuffer
+ *
+ * @param framebuffer
+ * @param p
+ * @return std::pair<int64_t, int64_t> the column and the row of the pixel
+ */
+inline std::pair<int64_t, int64_t> get_pixel_on_framebuffer(const Framebuffer &framebuffer, Point p)
+{
+    return std::make_pair(get_pixel_location_on_image(p.get_x(), framebuffer.get_width()),
+                          get_pixel_location_on_image(p.get_y(), framebuffer.get_height()));
+}
+
+/**
+ * @brief A function to add a point to a framebuffer, the parts of it outside the image are clipped
+ *
+ * @param framebuffer
+ * @param p
+ */
+void add_point_to_framebuffer(Framebuffer &framebuffer, Point p)
+{
+    std::pair<int64_t, int64_t> center = get_pixel_on_framebuffer(framebuffer, p);
+    framebuffer.stamp(center.first, center.second, POINT_THICKNESS, POINT_COLOR);
+}
+
+/**
+ * @brief A function to add a line to a framebuffer with Bresenham's algorithm, the parts of it outside the image are clipped
+ *
+ * @param framebuffer
+ * @param line
+ */
+void add_line_to_framebuffer(Framebuffer &framebuffer, Line line)
+{
+    std::pair<int64_t, int64_t> start = get_pixel_on_framebuffer(framebuffer, line.get_start());
+    std::pair<int64_t, int64_t> end = get_pixel_on_framebuffer(framebuffer, line.get_end());
+    framebuffer.draw_line(start.first, start.second, end.first, end.second, LINE_THICKNESS, LINE_COLOR);
+}